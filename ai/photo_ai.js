@@ -0,0 +1,10 @@
+// Demo "avatar generation": returns a derived file name and metadata. No image processing performed.
+const path = require('path');
+
+function generateAvatar(imagePath, style = 'cyberpunk') {
+  if (!imagePath) return { ok: false, error: 'imagePath required' };
+  const outFile = path.join(path.dirname(imagePath), `${path.basename(imagePath, path.extname(imagePath))}.${style}.avatar.png`);
+  return { ok: true, style, input: imagePath, output: outFile, note: 'Demo stub: plug in your model or API here.' };
+}
+
+module.exports = { generateAvatar };
\ No newline at end of file
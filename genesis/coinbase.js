@@ -0,0 +1,125 @@
+// Bitcoin-style genesis coinbase serialization.
+const crypto = require('crypto');
+const { IV, compress, readBlock, sha256From } = require('../mining/sha256');
+
+// Consensus limit on a coinbase scriptSig (genesis blocks are exempt).
+const MAX_SCRIPTSIG = 100;
+const EXTRANONCE_SIZE = 4;
+
+function varInt(n) {
+  if (n < 0xfd) return Buffer.from([n]);
+  if (n <= 0xffff) {
+    const b = Buffer.alloc(3);
+    b[0] = 0xfd;
+    b.writeUInt16LE(n, 1);
+    return b;
+  }
+  const b = Buffer.alloc(5);
+  b[0] = 0xfe;
+  b.writeUInt32LE(n, 1);
+  return b;
+}
+
+// Minimal script push of raw bytes (direct push, OP_PUSHDATA1 or OP_PUSHDATA2).
+function pushData(data) {
+  if (data.length < 0x4c) return Buffer.concat([Buffer.from([data.length]), data]);
+  if (data.length <= 0xff) return Buffer.concat([Buffer.from([0x4c, data.length]), data]);
+  const len = Buffer.alloc(2);
+  len.writeUInt16LE(data.length);
+  return Buffer.concat([Buffer.from([0x4d]), len, data]);
+}
+
+// CScriptNum encoding (little-endian, sign bit in the top byte).
+function scriptNum(n) {
+  const out = [];
+  let v = Math.abs(n);
+  while (v > 0) {
+    out.push(v & 0xff);
+    v = Math.floor(v / 256);
+  }
+  if (out.length && (out[out.length - 1] & 0x80)) out.push(n < 0 ? 0x80 : 0);
+  else if (n < 0) out[out.length - 1] |= 0x80;
+  return Buffer.from(out);
+}
+
+// scriptSig = <nBits> <4> <message>; with Bitcoin's nBits (486604799, the
+// default) exactly as in its genesis block.
+function genesisScriptSig(message, scriptSigBits = 486604799) {
+  return Buffer.concat([
+    pushData(scriptNum(scriptSigBits)),
+    pushData(scriptNum(4)),
+    pushData(Buffer.from(message, 'utf8'))
+  ]);
+}
+
+function buildCoinbase({ scriptSig, outputScript, reward, version = 1, lockTime = 0 }) {
+  const head = Buffer.alloc(4);
+  head.writeInt32LE(version);
+  const prevout = Buffer.alloc(36, 0);
+  prevout.writeUInt32LE(0xffffffff, 32);
+  const sequence = Buffer.from('ffffffff', 'hex');
+  const value = Buffer.alloc(8);
+  value.writeBigUInt64LE(BigInt(reward));
+  const lock = Buffer.alloc(4);
+  lock.writeUInt32LE(lockTime);
+
+  return Buffer.concat([
+    head,
+    varInt(1), prevout, varInt(scriptSig.length), scriptSig, sequence,
+    varInt(1), value, varInt(outputScript.length), outputScript,
+    lock
+  ]);
+}
+
+// `size` bytes of valid script that do nothing but take up room.
+function padding(size) {
+  return size ? pushData(Buffer.alloc(size - 1)) : Buffer.alloc(0);
+}
+
+// Coinbase whose scriptSig ends in a 4-byte extranonce push. Only the
+// extranonce and the bytes after it change between rolls, so the SHA-256
+// state over every whole block before the extranonce is cached and a roll
+// hashes just the tail.
+//
+// Inputs precede outputs, so the extranonce cannot move past them; instead a
+// pad (0..63 bytes) goes in front of the extranonce push, and the pad that
+// leaves the fewest tail blocks wins. Typically it slides the extranonce to
+// the start of a block. A pad never takes a scriptSig over the consensus
+// limit unless it is over it already (a long genesis message).
+class CoinbaseLayout {
+  constructor({ scriptSig, outputScript, reward }) {
+    const unpadded = scriptSig.length + 1 + EXTRANONCE_SIZE;
+    let best = null;
+    for (let pad = 0; pad < 64; pad++) {
+      const sig = Buffer.concat([scriptSig, padding(pad), pushData(Buffer.alloc(EXTRANONCE_SIZE))]);
+      if (pad && sig.length > MAX_SCRIPTSIG && unpadded <= MAX_SCRIPTSIG) break;
+      const coinbase = buildCoinbase({ scriptSig: sig, outputScript, reward });
+      // version | input count | prevout | scriptSig length | scriptSig
+      const offset = 4 + 1 + 36 + varInt(sig.length).length + sig.length - EXTRANONCE_SIZE;
+      const blocks = Math.ceil((coinbase.length + 9) / 64) - Math.floor(offset / 64);
+      if (!best || blocks < best.blocks) best = { pad, coinbase, offset, blocks };
+    }
+    this.pad = best.pad;
+    this.template = best.coinbase;
+    this.offset = best.offset;
+    this.blocksPerRoll = best.blocks;
+    this.prefixLength = Math.floor(best.offset / 64) * 64;
+    this.midstate = new Uint32Array(IV);
+    const block = new Uint32Array(16);
+    for (let off = 0; off < this.prefixLength; off += 64) compress(this.midstate, readBlock(this.template, off, block));
+  }
+
+  coinbaseFor(extranonce) {
+    const coinbase = Buffer.from(this.template);
+    coinbase.writeUInt32LE(extranonce >>> 0, this.offset);
+    return coinbase;
+  }
+
+  // sha256d of a coinbase from this layout, resuming from the cached prefix.
+  txidFor(coinbase) {
+    const first = sha256From(this.midstate, this.prefixLength, coinbase.subarray(this.prefixLength));
+    return crypto.createHash('sha256').update(first).digest();
+  }
+}
+
+module.exports = { varInt, pushData, scriptNum, genesisScriptSig, buildCoinbase, CoinbaseLayout };
@@ -0,0 +1,329 @@
+// Builds a genesis block end to end: coinbase -> merkle root -> header -> nonce search.
+const { WorkerPool } = require('../mining/worker_pool');
+const { buildHeader } = require('../mining/miner_core');
+const { bitsToTarget, meetsTarget, hashToHex } = require('../mining/target');
+const path = require('path');
+const { TemplateRoller } = require('../mining/template_roller');
+const { MultiScheduler } = require('../mining/multi_scheduler');
+const { CoinbaseMerkle } = require('../mining/merkle');
+const { SearchCheckpoint } = require('../mining/checkpoint');
+const { getCoin } = require('../mining/coins');
+const pow = require('../mining/pow');
+const { varInt, genesisScriptSig, buildCoinbase, CoinbaseLayout } = require('./coinbase');
+
+const COIN = 100000000n;
+
+// Bitcoin's genesis parameters; every field can be overridden by the spec.
+// `coin` selects the PoW algorithm and, unless nBits is given, the difficulty
+// from config/coins.json; `algorithm` overrides the coin's algorithm.
+const DEFAULTS = {
+  coin: 'soulvan',
+  message: 'The Times 03/Jan/2009 Chancellor on brink of second bailout for banks',
+  outputScript: '4104678afdb0fe5548271967f1a67130b7105cd6a828e03909a67962e0ea1f61deb649f6bc3f4cef38c4f35504e51ec112de5c384df7ba0b8d578a4c702b6bf11d5fac',
+  reward: 50n * COIN,
+  nTime: 1231006505,
+  version: 1,
+  nonceStart: 0,
+  timeWindow: 0,
+  checkpointSec: 30
+};
+
+// Checkpoints still being written; flushed on app quit.
+const ACTIVE = new Set();
+
+function parseNumber(v) {
+  return typeof v === 'string' && v.startsWith('0x') ? parseInt(v, 16) : Number(v);
+}
+
+function normalizeSpec(spec = {}) {
+  const s = { ...DEFAULTS, ...spec };
+  const coin = getCoin(s.coin);
+  return {
+    coin: coin.id,
+    algorithm: pow.get(s.algorithm || coin.algorithm).name,
+    message: String(s.message),
+    outputScript: Buffer.isBuffer(s.outputScript) ? s.outputScript : Buffer.from(String(s.outputScript), 'hex'),
+    reward: BigInt(s.reward),
+    nTime: parseNumber(s.nTime),
+    nBits: parseNumber(s.nBits ?? coin.genesisBits),
+    version: parseNumber(s.version),
+    nonceStart: parseNumber(s.nonceStart),
+    timeWindow: parseNumber(s.timeWindow),
+    checkpointSec: parseNumber(s.checkpointSec),
+    threads: s.threads
+  };
+}
+
+// Fields that define the search; a checkpoint only resumes an identical job.
+function jobParams(s) {
+  return {
+    algorithm: s.algorithm,
+    message: s.message,
+    outputScript: s.outputScript.toString('hex'),
+    reward: s.reward.toString(),
+    nTime: s.nTime,
+    nBits: s.nBits,
+    version: s.version,
+    nonceStart: s.nonceStart,
+    timeWindow: s.timeWindow,
+    // Rolled coinbases (extranonce >= 1) depend on the layout.
+    coinbaseLayout: 'padded-extranonce',
+    // The scriptSig's first push is nBits (it used to be Bitcoin's, always).
+    scriptSigBits: 'nBits'
+  };
+}
+
+// The scriptSig starts with the spec's nBits, as Bitcoin's does with its own.
+// Extranonce 0 is the plain genesis coinbase; later ones use a CoinbaseLayout
+// (padded 4-byte extranonce push) so each roll hashes only the tail blocks.
+function coinbaseBuilder(s) {
+  const scriptSig = genesisScriptSig(s.message, s.nBits);
+  const plain = buildCoinbase({ scriptSig, outputScript: s.outputScript, reward: s.reward });
+  const layout = new CoinbaseLayout({ scriptSig, outputScript: s.outputScript, reward: s.reward });
+  return { layout, coinbaseFor: (extranonce) => (extranonce > 0 ? layout.coinbaseFor(extranonce) : plain) };
+}
+
+// Everything up to the nonce search: coinbase, merkle root and unsolved header.
+function prepare(spec) {
+  const s = normalizeSpec(spec);
+  const { layout, coinbaseFor } = coinbaseBuilder(s);
+  const coinbase = coinbaseFor(0);
+  // A genesis block has only the coinbase: an empty branch, so the root is
+  // the coinbase txid and every extranonce roll costs one hash.
+  const merkle = new CoinbaseMerkle([]);
+  const merkleRoot = merkle.rootFor(coinbase);
+  const header = buildHeader({
+    version: s.version,
+    merkleRoot,
+    time: s.nTime,
+    bits: s.nBits,
+    nonce: s.nonceStart
+  });
+  const roller = new TemplateRoller({
+    header,
+    coinbaseFor,
+    merkleBranch: merkle.branch,
+    txidFor: (cb) => layout.txidFor(cb),
+    timeWindow: s.timeWindow
+  });
+  return { spec: s, coinbase, merkleRoot, header, roller, target: bitsToTarget(s.nBits), algo: pow.get(s.algorithm) };
+}
+
+function serializeBlock(header, coinbase) {
+  return Buffer.concat([header, varInt(1), coinbase]);
+}
+
+// Result of a solved search (the same shape for single and batch builds).
+function solvedResult(job, header, hash, template) {
+  return {
+    ok: true,
+    coin: job.spec.coin,
+    algorithm: job.algo.name,
+    hash: hashToHex(hash),
+    merkleRoot: hashToHex(header.subarray(36, 68)),
+    nonce: header.readUInt32LE(76),
+    nTime: header.readUInt32LE(68),
+    extranonce: template.extranonce,
+    nBits: '0x' + job.spec.nBits.toString(16).padStart(8, '0'),
+    version: job.spec.version,
+    header: header.toString('hex'),
+    coinbase: template.coinbase.toString('hex'),
+    block: serializeBlock(header, template.coinbase).toString('hex')
+  };
+}
+
+// Runs the parallel nonce search. onEvent receives { type: 'progress' | 'found', ... }.
+// With opts.checkpointDir the search is checkpointed every spec.checkpointSec
+// seconds and an interrupted run of the same job resumes where it stopped.
+// Rejects when a worker fails (the checkpoint is saved first).
+function build(spec, onEvent, opts = {}) {
+  const job = prepare(spec);
+  const pool = new WorkerPool({ threads: job.spec.threads });
+  const started = Date.now();
+
+  let checkpoint = null;
+  let resume = null;
+  if (opts.checkpointDir) {
+    checkpoint = new SearchCheckpoint({
+      dir: path.join(opts.checkpointDir, 'genesis-checkpoints'),
+      params: jobParams(job.spec),
+      intervalSec: job.spec.checkpointSec
+    });
+    resume = checkpoint.load();
+  }
+  const priorHashes = checkpoint ? checkpoint.hashes : 0;
+  let hashes = 0;
+
+  return new Promise((resolve, reject) => {
+    let done = false;
+    const tick = setInterval(() => {
+      hashes += pool.drainHashes();
+      const sec = (Date.now() - started) / 1000;
+      onEvent && onEvent({
+        type: 'progress',
+        hashes: priorHashes + hashes,
+        hashrate: Math.round(hashes / sec),
+        elapsedSec: sec,
+        resumed: !!resume,
+        workers: pool.workerStats()
+      });
+    }, 1000);
+
+    const { header, target, roller } = job;
+    pool.start({ header, target, roller, algorithm: job.algo.name, nonceStart: job.spec.nonceStart, resume }, {
+      onChunkDone: checkpoint ? (w, t, start, end) => checkpoint.markDone(w, t, start, end) : null,
+      onFound: ({ header, template }) => {
+        if (done) return;
+        const hash = job.algo.hash(header);
+        if (!meetsTarget(hash, job.target)) return;
+        done = true;
+        clearInterval(tick);
+        pool.stop();
+        hashes += pool.drainHashes();
+        if (checkpoint) {
+          checkpoint.remove();
+          ACTIVE.delete(checkpoint);
+        }
+
+        const result = {
+          ...solvedResult(job, header, hash, template),
+          hashes: priorHashes + hashes,
+          resumed: !!resume,
+          threads: pool.size,
+          elapsedMs: Date.now() - started
+        };
+        onEvent && onEvent({ type: 'found', ...result });
+        resolve(result);
+      },
+      onError: (worker, err) => {
+        if (done) return;
+        done = true;
+        clearInterval(tick);
+        if (checkpoint) checkpoint.refresh();
+        pool.stop();
+        if (checkpoint) {
+          checkpoint.stopTimer();
+          checkpoint.save();
+          ACTIVE.delete(checkpoint);
+        }
+        reject(new Error(`Genesis search failed: ${err.message}`));
+      }
+    });
+
+    if (checkpoint) {
+      checkpoint.refresh = () => {
+        checkpoint.hashes = priorHashes + hashes;
+        checkpoint.setCursor(pool.cursor());
+      };
+      checkpoint.startTimer(checkpoint.refresh);
+      ACTIVE.add(checkpoint);
+    }
+  });
+}
+
+// Solves several genesis specs (e.g. mainnet, testnet, regtest) in one run on
+// one worker pool. Their chunks are interleaved by a MultiScheduler in
+// proportion to each spec's expected work, and a solved spec's share of the
+// cores goes to the others at once, so the wall time approaches the summed
+// expected work divided by the core count instead of a sum of tails.
+// Each spec may carry a `name`; opts.threads sizes the pool. onEvent receives
+// 'progress' (with per-spec progress) and one 'found' per spec. Resolves with
+// a single report: { ok, results: [{ name, ...build result }], hashes, ... };
+// rejects when a worker fails.
+function buildBatch(specs, onEvent, opts = {}) {
+  if (!Array.isArray(specs) || !specs.length) return Promise.resolve({ ok: false, error: 'No genesis specs given' });
+  const jobs = specs.map((spec, i) => ({ name: spec.name || `spec-${i}`, ...prepare(spec) }));
+  const pool = new WorkerPool({ threads: opts.threads ?? jobs[0].spec.threads });
+  const scheduler = new MultiScheduler({
+    workers: pool.size,
+    searches: jobs.map((job, key) => ({
+      key,
+      roller: job.roller,
+      target: job.target,
+      algorithm: job.algo.name,
+      nonceStart: job.spec.nonceStart
+    }))
+  });
+  const started = Date.now();
+  const results = new Array(jobs.length).fill(null);
+  let hashes = 0;
+
+  return new Promise((resolve, reject) => {
+    let failed = false;
+    const tick = setInterval(() => {
+      hashes += pool.drainHashes();
+      const sec = (Date.now() - started) / 1000;
+      onEvent && onEvent({
+        type: 'progress',
+        hashes,
+        hashrate: Math.round(hashes / sec),
+        elapsedSec: sec,
+        specs: scheduler.progress().map(p => ({ name: jobs[p.key].name, ...p })),
+        workers: pool.workerStats()
+      });
+    }, 1000);
+
+    pool.start({ scheduler }, {
+      onFound: ({ header, template }) => {
+        if (!template || failed) return;
+        const key = template.key;
+        const job = jobs[key];
+        if (results[key]) return;
+        const hash = job.algo.hash(header);
+        if (!meetsTarget(hash, job.target)) return;
+        scheduler.remove(key);
+        const elapsedMs = Date.now() - started;
+        results[key] = { name: job.name, ...solvedResult(job, header, hash, template), elapsedMs };
+        onEvent && onEvent({ type: 'found', ...results[key] });
+        if (scheduler.remaining) return;
+
+        clearInterval(tick);
+        pool.stop();
+        hashes += pool.drainHashes();
+        const progress = scheduler.progress();
+        const expected = progress.reduce((n, p) => n + p.expected, 0);
+        resolve({
+          ok: true,
+          results: results.map((r, k) => ({ ...r, hashes: progress[k].hashes, expectedHashes: progress[k].expected })),
+          hashes,
+          expectedHashes: expected,
+          threads: pool.size,
+          elapsedMs
+        });
+      },
+      onError: (worker, err) => {
+        if (failed) return;
+        failed = true;
+        clearInterval(tick);
+        pool.stop();
+        reject(new Error(`Genesis search failed: ${err.message}`));
+      }
+    });
+  });
+}
+
+// Writes every running search's checkpoint now (called before the app quits).
+function flushCheckpoints() {
+  for (const cp of ACTIVE) {
+    cp.refresh();
+    cp.save();
+  }
+}
+
+if (require.main === module) {
+  const spec = process.argv[2] ? JSON.parse(process.argv[2]) : {};
+  const checkpointDir = process.argv[3];
+  process.on('SIGINT', () => {
+    flushCheckpoints();
+    process.exit(130);
+  });
+  const onEvent = (evt) => {
+    if (evt.type === 'progress') console.error(`${evt.hashes} hashes, ${evt.hashrate} H/s`);
+    if (evt.type === 'found' && evt.name) console.error(`${evt.name} solved: ${evt.hash}`);
+  };
+  // An array of specs is a batch run (no checkpoints).
+  const run = Array.isArray(spec) ? buildBatch(spec, onEvent) : build(spec, onEvent, { checkpointDir });
+  run.then(r => console.log(JSON.stringify(r, null, 2)));
+}
+
+module.exports = { build, buildBatch, prepare, serializeBlock, flushCheckpoints, DEFAULTS };
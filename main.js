@@ -0,0 +1,191 @@
+const { app, BrowserWindow, ipcMain } = require('electron');
+const path = require('path');
+
+// Built-in demo miner
+const minerCore = require('./mining/miner_core');
+const poolMining = require('./mining/pool_mining');
+const stratumProxy = require('./mining/stratum_proxy');
+const soloMining = require('./mining/solo_mining');
+const coins = require('./mining/coins');
+// External miner orchestrator
+const extMiner = require('./mining/external_miners');
+
+// Wallets
+const soulvanWallet = require('./wallet/soulvan_integration');
+const tonWallet = require('./wallet/ton_integration');
+
+// AI
+const musicAI = require('./ai/music_ai');
+const photoAI = require('./ai/photo_ai');
+
+// Genesis block builder
+const genesis = require('./genesis/genesis_builder');
+
+// DAO and Scripts
+const governance = require('./dao/governance');
+const diagnostics = require('./scripts/diagnostics');
+const benchmark = require('./scripts/benchmark');
+const dockerMgr = require('./docker/docker_manager');
+
+let mainWindow;
+
+function createWindow () {
+  mainWindow = new BrowserWindow({
+    width: 1280,
+    height: 860,
+    webPreferences: {
+      preload: path.join(__dirname, 'src', 'preload.js'),
+      contextIsolation: true,
+      nodeIntegration: false
+    }
+  });
+
+  mainWindow.loadFile(path.join(__dirname, 'src', 'index.html'));
+}
+
+app.whenReady().then(() => {
+  createWindow();
+
+  // Mining IPC - supports built-in demo and external miners
+  ipcMain.handle('mining:start', async (_e, options) => {
+    // Miners started with the proxy option share one pool session per pool
+    // and user: they connect to that local proxy instead of the pool.
+    if (options.mode === 'pool' && options.proxy) {
+      try {
+        const proxy = await stratumProxy.ensureProxy({
+          url: options.poolUrl,
+          user: options.address || options.wallet,
+          password: options.password || 'x'
+        });
+        options = { ...options, poolUrl: proxy.url };
+      } catch (e) {
+        return { ok: false, error: `Proxy: ${e.message}` };
+      }
+    }
+    if (options.engine === 'external') {
+      const id = extMiner.startExternal(options, (evt) => {
+        if (!mainWindow || mainWindow.isDestroyed()) return;
+        if (evt.type === 'stats') mainWindow.webContents.send('mining:stats', evt);
+        if (evt.type === 'log') mainWindow.webContents.send('mining:log', evt);
+        if (evt.type === 'start' || evt.type === 'exit' || evt.type === 'error' || evt.type === 'schedule') {
+          mainWindow.webContents.send('mining:event', evt);
+        }
+      });
+      return { id, external: true };
+    }
+    let id;
+    const onStats = (stats) => {
+      if (mainWindow && !mainWindow.isDestroyed()) {
+        mainWindow.webContents.send('mining:stats', { id, ...stats });
+      }
+    };
+    const onEvent = (evt) => {
+      if (mainWindow && !mainWindow.isDestroyed()) mainWindow.webContents.send('mining:event', evt);
+    };
+    try {
+      // Built-in engine in pool mode speaks Stratum v1 to the pool itself.
+      id = options.mode === 'pool'
+        ? await poolMining.start(options, onStats, onEvent)
+        : minerCore.start(options, onStats, onEvent);
+    } catch (e) {
+      return { ok: false, error: e.message };
+    }
+    return { id, external: false };
+  });
+
+  ipcMain.handle('mining:stop', async (_e, { id, external }) => {
+    if (external) {
+      extMiner.stopExternal(id);
+      return { stopped: true };
+    }
+    if (!poolMining.stop(id)) minerCore.stop(id);
+    return { stopped: true };
+  });
+
+  ipcMain.handle('mining:proxy', async () => stratumProxy.proxyStats());
+
+  ipcMain.handle('mining:intensity', async (_e, { id, intensity }) => minerCore.setIntensity(id, intensity));
+
+  ipcMain.handle('mining:mode', async (_e, { mode, options }) => {
+    if (mode === 'pool') return poolMining.configure(options || {});
+    if (mode === 'solo') return soloMining.configure(options || {});
+    return { ok: false, error: 'Unknown mode' };
+  });
+
+  ipcMain.handle('mining:presets', async () => {
+    return extMiner.MINERS_CFG;
+  });
+
+  ipcMain.handle('mining:coins', async () => coins.listCoins());
+
+  // Wallet IPC
+  ipcMain.handle('wallet:getBalance', async (_e, { coin, address }) => {
+    if (coin === 'soulvan') return soulvanWallet.getBalance(address);
+    if (coin === 'ton') return tonWallet.getBalance(address);
+    return { ok: false, error: 'Unknown coin' };
+  });
+
+  ipcMain.handle('wallet:create', async (_e, { coin }) => {
+    if (coin === 'soulvan') return soulvanWallet.createWallet();
+    if (coin === 'ton') return tonWallet.createWallet();
+    return { ok: false, error: 'Unknown coin' };
+  });
+
+  ipcMain.handle('wallet:send', async (_e, { coin, from, to, amount }) => {
+    if (coin === 'soulvan') return soulvanWallet.send(from, to, amount);
+    if (coin === 'ton') return tonWallet.send(from, to, amount);
+    return { ok: false, error: 'Unknown coin' };
+  });
+
+  // AI IPC
+  ipcMain.handle('ai:music:generate', async (_e, { prompt, lengthSec }) => {
+    return musicAI.generate(prompt, lengthSec);
+  });
+
+  ipcMain.handle('ai:photo:avatar', async (_e, { imagePath, style }) => {
+    return photoAI.generateAvatar(imagePath, style);
+  });
+
+  // Genesis IPC
+  // An array of specs builds them together on one pool (see buildBatch).
+  ipcMain.handle('genesis:build', async (_e, spec) => {
+    const onEvent = (evt) => {
+      if (mainWindow && !mainWindow.isDestroyed()) mainWindow.webContents.send('genesis:event', evt);
+    };
+    try {
+      if (Array.isArray(spec)) return await genesis.buildBatch(spec, onEvent);
+      return await genesis.build(spec || {}, onEvent, { checkpointDir: app.getPath('userData') });
+    } catch (e) {
+      return { ok: false, error: String(e.message || e) };
+    }
+  });
+
+  // DAO IPC
+  ipcMain.handle('dao:list', async () => governance.listProposals());
+  ipcMain.handle('dao:vote', async (_e, { proposalId, choice }) => governance.vote(proposalId, choice));
+  ipcMain.handle('dao:create', async (_e, { title, description }) => governance.createProposal(title, description));
+
+  // Scripts IPC
+  ipcMain.handle('scripts:diagnostics', async () => ({
+    ...diagnostics.collect(),
+    placement: { builtIn: minerCore.placement(), external: extMiner.placement() }
+  }));
+  ipcMain.handle('scripts:benchmark', async (_e, { seconds }) => benchmark.run(seconds));
+
+  // Docker IPC
+  ipcMain.handle('docker:build', async (_e, { tag }) => dockerMgr.build(tag));
+  ipcMain.handle('docker:run', async (_e, { tag, args }) => dockerMgr.run(tag, args));
+
+  app.on('activate', function () {
+    if (BrowserWindow.getAllWindows().length === 0) createWindow();
+  });
+});
+
+app.on('before-quit', () => {
+  genesis.flushCheckpoints();
+  stratumProxy.stopProxy();
+});
+
+app.on('window-all-closed', function () {
+  if (process.platform !== 'darwin') app.quit();
+});
\ No newline at end of file
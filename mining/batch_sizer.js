@@ -0,0 +1,35 @@
+const ALPHA = 0.3;
+
+// Picks how many hashes to run before yielding so that one slice takes about
+// targetMs. Every finished slice's measured rate feeds an EWMA and the next
+// batch is rate * targetMs, clamped to [min, max]. Growth is limited to 4x per
+// slice so a slow first (cold JIT) slice cannot overshoot by orders of magnitude.
+class BatchSizer {
+  constructor({ targetMs, initial = 1000, min = 1, max = 1 << 24 }) {
+    this.targetMs = targetMs;
+    this.min = min;
+    this.max = max;
+    this.size = Math.min(max, Math.max(min, Math.round(initial)));
+    this.rate = 0; // hashes per ms
+    this.started = 0n;
+  }
+
+  // Starts timing a slice and returns how many hashes it should run.
+  start() {
+    this.started = process.hrtime.bigint();
+    return this.size;
+  }
+
+  // Records the hashes actually done since start(); returns the slice's duration in ms.
+  done(hashes) {
+    const ms = Number(process.hrtime.bigint() - this.started) / 1e6;
+    if (!hashes || !(ms > 0)) return ms;
+    const rate = hashes / ms;
+    this.rate = this.rate ? this.rate + ALPHA * (rate - this.rate) : rate;
+    const next = Math.min(this.size * 4, Math.round(this.rate * this.targetMs));
+    this.size = Math.min(this.max, Math.max(this.min, next));
+    return ms;
+  }
+}
+
+module.exports = { BatchSizer };
@@ -0,0 +1,164 @@
+const fs = require('fs');
+const path = require('path');
+const crypto = require('crypto');
+
+const FORMAT = 1;
+
+// Adds [start, end) to a sorted list of disjoint ranges, merging neighbours.
+function addRange(ranges, start, end) {
+  let i = 0;
+  while (i < ranges.length && ranges[i][1] < start) i++;
+  let s = start;
+  let e = end;
+  let j = i;
+  while (j < ranges.length && ranges[j][0] <= e) {
+    s = Math.min(s, ranges[j][0]);
+    e = Math.max(e, ranges[j][1]);
+    j++;
+  }
+  ranges.splice(i, j - i, [s, e]);
+  return ranges;
+}
+
+// Parts of [from, to) not covered by the sorted disjoint `done` ranges.
+function freeRanges(done, from, to) {
+  const out = [];
+  let pos = from;
+  for (const [s, e] of done) {
+    if (e <= pos) continue;
+    if (s >= to) break;
+    if (s > pos) out.push([pos, s]);
+    pos = Math.max(pos, e);
+  }
+  if (pos < to) out.push([pos, to]);
+  return out;
+}
+
+// Periodic on-disk record of a long nonce search: the job parameters, how far
+// the template roller got (extranonce/nTime cursor) and the nonce ranges each
+// worker has finished per template. Only completed chunks are recorded, so a
+// resumed search neither skips nor repeats finished ranges. Templates below
+// the scheduler's oldest live one are finished: they collapse into
+// `doneBelow` and their ranges are dropped, so the file stays small.
+class SearchCheckpoint {
+  constructor({ dir, params, intervalSec = 30 }) {
+    this.params = params;
+    this.id = crypto.createHash('sha256').update(JSON.stringify(params)).digest('hex').slice(0, 16);
+    this.file = path.join(dir, `search-${this.id}.json`);
+    this.intervalSec = intervalSec;
+    this.workers = new Map(); // worker -> Map(template -> ranges)
+    this.rolled = 0;
+    this.doneBelow = 0;
+    this.cursor = null;
+    this.hashes = 0;
+    this.timer = null;
+  }
+
+  // Loads a previous checkpoint for the same params. Returns null when there is none.
+  load() {
+    let data;
+    try {
+      data = JSON.parse(fs.readFileSync(this.file, 'utf8'));
+    } catch {
+      return null;
+    }
+    if (data.format !== FORMAT || JSON.stringify(data.params) !== JSON.stringify(this.params)) return null;
+    for (const w of data.workers) {
+      const byTemplate = new Map();
+      for (const [template, start, end] of w.ranges) {
+        if (!byTemplate.has(template)) byTemplate.set(template, []);
+        addRange(byTemplate.get(template), start, end);
+      }
+      this.workers.set(w.worker, byTemplate);
+    }
+    this.rolled = data.rolled;
+    this.doneBelow = data.doneBelow || 0;
+    this.cursor = data.cursor;
+    this.hashes = data.hashes || 0;
+    return { rolled: this.rolled, doneBelow: this.doneBelow, completed: this.completed() };
+  }
+
+  // All workers' finished ranges merged per template (for seeding the scheduler).
+  completed() {
+    const merged = new Map();
+    for (const byTemplate of this.workers.values()) {
+      for (const [template, ranges] of byTemplate) {
+        if (!merged.has(template)) merged.set(template, []);
+        for (const [s, e] of ranges) addRange(merged.get(template), s, e);
+      }
+    }
+    return merged;
+  }
+
+  markDone(worker, template, start, end) {
+    if (template < this.doneBelow) return;
+    if (!this.workers.has(worker)) this.workers.set(worker, new Map());
+    const byTemplate = this.workers.get(worker);
+    if (!byTemplate.has(template)) byTemplate.set(template, []);
+    addRange(byTemplate.get(template), start, end);
+  }
+
+  // cursor: { index, extranonce, nTime } of the newest rolled template and
+  // `oldest`, the oldest template the scheduler still has work for.
+  setCursor(cursor) {
+    this.rolled = cursor.index;
+    this.cursor = cursor;
+    if (cursor.oldest > this.doneBelow) {
+      this.doneBelow = cursor.oldest;
+      for (const byTemplate of this.workers.values()) {
+        for (const template of byTemplate.keys()) if (template < this.doneBelow) byTemplate.delete(template);
+      }
+    }
+  }
+
+  save() {
+    const workers = [];
+    for (const [worker, byTemplate] of this.workers) {
+      const ranges = [];
+      for (const [template, rs] of byTemplate) for (const [s, e] of rs) ranges.push([template, s, e]);
+      workers.push({ worker, ranges });
+    }
+    const data = {
+      format: FORMAT,
+      params: this.params,
+      rolled: this.rolled,
+      doneBelow: this.doneBelow,
+      cursor: this.cursor,
+      hashes: this.hashes,
+      savedAt: new Date().toISOString(),
+      workers
+    };
+    fs.mkdirSync(path.dirname(this.file), { recursive: true });
+    const tmp = `${this.file}.tmp`;
+    fs.writeFileSync(tmp, JSON.stringify(data));
+    fs.renameSync(tmp, this.file);
+  }
+
+  // Saves every intervalSec; `before` runs first to refresh counters.
+  startTimer(before) {
+    this.timer = setInterval(() => {
+      before && before();
+      try {
+        this.save();
+      } catch (e) {
+        console.error('checkpoint save failed:', e);
+      }
+    }, this.intervalSec * 1000);
+    this.timer.unref();
+  }
+
+  stopTimer() {
+    if (this.timer) clearInterval(this.timer);
+    this.timer = null;
+  }
+
+  // The search finished; nothing left to resume.
+  remove() {
+    this.stopTimer();
+    try {
+      fs.unlinkSync(this.file);
+    } catch {}
+  }
+}
+
+module.exports = { SearchCheckpoint, addRange, freeRanges };
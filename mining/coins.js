@@ -0,0 +1,28 @@
+// Coin definitions from config/coins.json: which PoW algorithm a coin mines
+// and its default share / genesis difficulty.
+const path = require('path');
+const pow = require('./pow');
+
+const COINS = require(path.join(__dirname, '..', 'config', 'coins.json')).coins;
+
+function parseBits(v) {
+  return typeof v === 'string' ? parseInt(v, 16) : Number(v);
+}
+
+// Coin `id` with its algorithm resolved; unknown ids throw.
+function getCoin(id = 'soulvan') {
+  const coin = COINS.find(c => c.id === id);
+  if (!coin) throw new Error(`Unknown coin: ${id}`);
+  return {
+    ...coin,
+    shareBits: parseBits(coin.shareBits),
+    genesisBits: parseBits(coin.genesisBits),
+    pow: pow.get(coin.algorithm)
+  };
+}
+
+function listCoins() {
+  return COINS.map(({ id, name, algorithm }) => ({ id, name, algorithm }));
+}
+
+module.exports = { getCoin, listCoins };
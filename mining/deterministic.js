@@ -0,0 +1,56 @@
+// Reproducible searches: a fixed header, a seeded nonce order and a fixed
+// chunk size (see SeededScheduler) give the same share after the same
+// canonical hash count on every run, with any thread count. Used as an exact
+// correctness and throughput fixture by the benchmark and the tests.
+const { WorkerPool } = require('./worker_pool');
+const { buildHeader, SEEDED_TIME } = require('./miner_core');
+const { bitsToTarget } = require('./target');
+const { sha256d } = require('./sha256');
+
+// Fixed header for a seed: nothing in it depends on the clock or randomness.
+function fixtureHeader(seed, bits) {
+  return buildHeader({
+    version: 0x20000000,
+    prevHash: sha256d(`soulvan-fixture-prev|${seed}`),
+    merkleRoot: sha256d(`soulvan-fixture-merkle|${seed}`),
+    time: SEEDED_TIME,
+    bits
+  });
+}
+
+// options: { seed, bits, header, algorithm, chunk, threads }. Resolves with
+// { nonce, hash, header, template, hashes, elapsedMs, hashrate }: `hashes`
+// is the canonical count up to the solution, the same on every run.
+function searchSeeded({ seed = 0, bits = 0x1f00ffff, header, algorithm = 'sha256d', chunk, threads = 1 } = {}) {
+  const pool = new WorkerPool({ threads });
+  const target = bitsToTarget(bits);
+  const started = Date.now();
+  return new Promise((resolve) => {
+    const finish = (solution) => {
+      if (!solution) return;
+      pool.stop();
+      const elapsedMs = Date.now() - started;
+      resolve({
+        nonce: solution.nonce,
+        hash: solution.hash,
+        header: solution.header,
+        template: solution.template,
+        hashes: solution.hashes,
+        elapsedMs,
+        hashrate: elapsedMs ? Math.round(solution.hashes * 1000 / elapsedMs) : 0
+      });
+    };
+    pool.start({
+      header: header || fixtureHeader(seed, bits),
+      target,
+      algorithm,
+      seed,
+      chunk
+    }, {
+      onFound: (f) => finish(pool.scheduler.offer({ ...f, template: f.template.index })),
+      onChunkDone: (worker, template, start) => finish(pool.scheduler.complete(template, start))
+    });
+  });
+}
+
+module.exports = { searchSeeded, fixtureHeader };
@@ -0,0 +1,193 @@
+const { spawn } = require('child_process');
+const path = require('path');
+const fs = require('fs');
+const { HashrateEstimator } = require('./hashrate');
+const { IdleScheduler } = require('./idle_scheduler');
+const { LoadSampler } = require('./system_load');
+const topology = require('./topology');
+
+const MINERS_CFG = (() => {
+  try {
+    const p = path.join(process.cwd(), 'config', 'miners.json');
+    return JSON.parse(fs.readFileSync(p, 'utf8'));
+  } catch {
+    return { presets: [] };
+  }
+})();
+
+const PROCS = new Map();
+let COUNTER = 1;
+
+function unitToHps(num, unit) {
+  const m = unit.toLowerCase();
+  if (m.includes('gh')) return num * 1e9;
+  if (m.includes('mh')) return num * 1e6;
+  if (m.includes('kh')) return num * 1e3;
+  return num;
+}
+
+function parseHashrate(line, hashrateRegexes = []) {
+  for (const r of hashrateRegexes) {
+    const re = new RegExp(r, 'i');
+    const m = line.match(re);
+    if (m && m[1]) {
+      const val = parseFloat(m[1]);
+      const unit = m[2] || 'H/s';
+      return unitToHps(val, unit);
+    }
+  }
+  const generic = line.match(/([0-9.]+)\s*(H\/s|kH\/s|MH\/s|GH\/s)/i);
+  if (generic) return unitToHps(parseFloat(generic[1]), generic[2]);
+  return null;
+}
+
+function formatArgs(template, vars) {
+  return template
+    .replaceAll('{POOL_URL}', vars.poolUrl || '')
+    .replaceAll('{WALLET}', vars.wallet || '')
+    .replaceAll('{PASSWORD}', vars.password ?? 'x')
+    .replaceAll('{THREADS}', String(vars.threads ?? ''))
+    .trim()
+    .split(/\s+/)
+    .filter(Boolean);
+}
+
+// options.idle ({ minThreads, maxThreads } or true) restarts the miner with a
+// new {THREADS} value as system load changes; decisions arrive as 'schedule' events.
+// options.affinity runs the miner under `taskset -c` on as many CPUs as it has
+// threads, picked like the built-in pool's and away from the CPUs other pinned
+// miners hold (Linux only).
+function startExternal(options, onEvent) {
+  const { presetId, exePath, poolUrl, wallet, password = 'x', threads, extraArgs = '', idle, affinity } = options;
+  const id = COUNTER++;
+  const preset = (MINERS_CFG.presets || []).find(p => p.id === presetId) || {};
+  const hashrateRegexes = preset.hashrateRegexes || [];
+  const argsFor = (t) => preset.argsTemplate
+    ? formatArgs(preset.argsTemplate + (extraArgs ? ` ${extraArgs}` : ''), { poolUrl, wallet, password, threads: t })
+    : (extraArgs ? extraArgs.split(/\s+/) : []);
+
+  const state = { id, exePath, args: argsFor(threads), cpus: null, startTime: Date.now(), hashrate: 0, shares: 0, accepted: 0, rejected: 0 };
+  // Reported rates go through the same estimator as the built-in engine, so the
+  // numbers are comparable regardless of how often the miner prints them.
+  const estimator = new HashrateEstimator();
+  const rec = { child: null, state, hashrateRegexes, scheduler: null };
+  PROCS.set(id, rec);
+
+  function handle(line) {
+    onEvent && onEvent({ type: 'log', id, line });
+    const hr = parseHashrate(line, hashrateRegexes);
+    if (hr) {
+      estimator.addRate(hr);
+      const { hashrates, totalHashes } = estimator.snapshot();
+      state.hashrate = hashrates['10s'];
+      onEvent && onEvent({
+        type: 'stats',
+        id,
+        hashrate: state.hashrate,
+        hashrates,
+        totalHashes,
+        reported: hr,
+        shares: state.shares,
+        accepted: state.accepted,
+        rejected: state.rejected,
+        uptimeSec: Math.floor((Date.now() - state.startTime) / 1000)
+      });
+    }
+    if (/share\s+accepted/i.test(line)) { state.accepted++; state.shares++; }
+    if (/share\s+rejected/i.test(line)) { state.rejected++; state.shares++; }
+  }
+
+  // Without a thread count the miner sizes itself, so it is left unpinned.
+  function launch(t) {
+    const args = argsFor(t);
+    const cpus = affinity && Number(t) > 0
+      ? [...new Set(topology.claim(rec, Number(t)).map(p => p.cpu))]
+      : [];
+    const pinned = topology.tasksetCommand(exePath, args, cpus);
+    const child = spawn(pinned ? pinned.command : exePath, pinned ? pinned.args : args, {
+      cwd: path.dirname(exePath),
+      windowsHide: true,
+      shell: false,
+      env: { ...process.env }
+    });
+    rec.child = child;
+    state.args = args;
+    state.cpus = pinned ? cpus : null;
+    if (!pinned) topology.release(rec);
+    child.stdout.on('data', (d) => String(d).split(/\r?\n/).forEach(s => s && handle(s)));
+    child.stderr.on('data', (d) => String(d).split(/\r?\n/).forEach(s => s && handle(s)));
+    child.on('close', (code) => {
+      if (rec.child !== child) return; // replaced by a scheduler restart
+      onEvent && onEvent({ type: 'exit', id, code });
+      stopScheduler(rec);
+      topology.release(rec);
+      PROCS.delete(id);
+    });
+    child.on('error', (err) => {
+      if (rec.child !== child) return;
+      onEvent && onEvent({ type: 'error', id, error: String(err) });
+      stopScheduler(rec);
+      topology.release(rec);
+      PROCS.delete(id);
+    });
+    onEvent && onEvent({ type: 'start', id, exePath, args, cpus: state.cpus });
+  }
+
+  if (idle) {
+    const bounds = idle === true ? {} : idle;
+    // Replaced miners keep running until they exit (up to the SIGKILL); their
+    // time is still the miner's, not foreign load.
+    const dying = new Set();
+    const sampler = new LoadSampler({
+      pids: () => [rec.child, ...dying].filter(c => c && c.pid).map(c => c.pid)
+    });
+    rec.scheduler = new IdleScheduler({
+      min: Number(bounds.minThreads) || 1,
+      max: Number(bounds.maxThreads) || Number(threads) || sampler.cpus,
+      sampler,
+      // External miners only take a thread count at launch, so a change is a restart.
+      apply: (n) => {
+        const old = rec.child;
+        dying.add(old);
+        old.once('close', () => dying.delete(old));
+        kill(old);
+        launch(n);
+      },
+      onDecision: (d) => onEvent && onEvent({ ...d, id })
+    });
+    launch(rec.scheduler.active);
+    rec.scheduler.start();
+  } else {
+    launch(threads);
+  }
+
+  return id;
+}
+
+function kill(child) {
+  try {
+    child.kill('SIGINT');
+    setTimeout(() => child.kill('SIGKILL'), 1500);
+  } catch {}
+}
+
+function stopScheduler(rec) {
+  if (rec.scheduler) rec.scheduler.stop();
+}
+
+function stopExternal(id) {
+  const rec = PROCS.get(id);
+  if (!rec) return false;
+  stopScheduler(rec);
+  topology.release(rec);
+  kill(rec.child);
+  PROCS.delete(id);
+  return true;
+}
+
+// CPUs each running external miner is pinned to (null when unpinned), for diagnostics.
+function placement() {
+  return [...PROCS.values()].map(({ state }) => ({ id: state.id, exePath: state.exePath, cpus: state.cpus }));
+}
+
+module.exports = { startExternal, stopExternal, placement, MINERS_CFG };
\ No newline at end of file
@@ -0,0 +1,40 @@
+// Batch hashing over a packed buffer: `count` inputs of `stride` bytes laid out
+// back to back, digests returned back to back in one Buffer. With the native
+// addon the whole batch is one call (SIMD/SHA-NI for the SHA-256 family);
+// otherwise it loops over node's crypto.
+const crypto = require('crypto');
+const native = require('./native');
+const { sha256d } = require('./sha256');
+
+const DIGEST_SIZE = { sha256: 32, sha256d: 32, ripemd160: 20 };
+
+function hashOne(algorithm, data) {
+  if (algorithm === 'sha256d') return sha256d(data);
+  return crypto.createHash(algorithm).update(data).digest();
+}
+
+function hashMany(algorithm, packed, stride, count = Math.floor(packed.length / stride)) {
+  const size = DIGEST_SIZE[algorithm];
+  if (!size) throw new Error(`hashMany: unsupported algorithm ${algorithm}`);
+  if (stride * count > packed.length) throw new RangeError('hashMany: stride * count exceeds the input length');
+  if (native.available) return native.addon.hashMany(algorithm, packed, stride, count);
+
+  const out = Buffer.allocUnsafe(size * count);
+  for (let i = 0; i < count; i++) {
+    hashOne(algorithm, packed.subarray(i * stride, (i + 1) * stride)).copy(out, i * size);
+  }
+  return out;
+}
+
+// Packs equal-length inputs (Buffers or strings) for hashMany.
+function pack(items, stride) {
+  const out = Buffer.alloc(stride * items.length);
+  items.forEach((item, i) => {
+    const buf = Buffer.isBuffer(item) ? item : Buffer.from(item);
+    if (buf.length !== stride) throw new RangeError(`hashMany: item ${i} is ${buf.length} bytes, expected ${stride}`);
+    buf.copy(out, i * stride);
+  });
+  return out;
+}
+
+module.exports = { hashMany, pack, DIGEST_SIZE };
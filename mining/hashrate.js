@@ -0,0 +1,60 @@
+// Hashrate estimator shared by the built-in and external engines.
+//
+// Keeps exponentially weighted averages over 10 s, 60 s and 15 min plus the
+// session total. Each sample is weighted by the time it covers (alpha =
+// 1 - e^(-dt/tau)), so irregular sample intervals, such as external miner log
+// lines, average the same way as the built-in 1 s tick. Until a window has
+// filled, its value is divided by the weight accumulated so far, so the 15 min
+// figure is meaningful from the first sample instead of ramping up from zero.
+const WINDOWS = [
+  ['10s', 10],
+  ['60s', 60],
+  ['15m', 900]
+];
+
+class HashrateEstimator {
+  constructor(now = process.hrtime.bigint()) {
+    this.started = now;
+    this.last = now;
+    this.totalHashes = 0;
+    this.ewma = WINDOWS.map(() => 0);
+  }
+
+  // Counts `hashes` finished since the previous sample (built-in engine).
+  addHashes(hashes, now = process.hrtime.bigint()) {
+    const dt = Number(now - this.last) / 1e9;
+    this.totalHashes += hashes;
+    if (dt <= 0) return;
+    this.last = now;
+    this._fold(hashes / dt, dt);
+  }
+
+  // Takes a reported rate as holding since the previous sample (external miners).
+  addRate(hps, now = process.hrtime.bigint()) {
+    const dt = Number(now - this.last) / 1e9;
+    if (dt <= 0) return;
+    this.last = now;
+    this.totalHashes += hps * dt;
+    this._fold(hps, dt);
+  }
+
+  _fold(rate, dt) {
+    WINDOWS.forEach(([, tau], i) => {
+      this.ewma[i] += (1 - Math.exp(-dt / tau)) * (rate - this.ewma[i]);
+    });
+  }
+
+  // { '10s', '60s', '15m', session } in H/s, and the session hash total.
+  snapshot() {
+    const elapsed = Number(this.last - this.started) / 1e9;
+    const rates = {};
+    WINDOWS.forEach(([name, tau], i) => {
+      const weight = 1 - Math.exp(-elapsed / tau);
+      rates[name] = weight > 0 ? Math.round(this.ewma[i] / weight) : 0;
+    });
+    rates.session = elapsed > 0 ? Math.round(this.totalHashes / elapsed) : 0;
+    return { hashrates: rates, totalHashes: Math.round(this.totalHashes) };
+  }
+}
+
+module.exports = { HashrateEstimator };
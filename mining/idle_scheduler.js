@@ -0,0 +1,73 @@
+const { LoadSampler } = require('./system_load');
+
+const SAMPLE_MS = 2000;
+// Consecutive samples needed before acting: foreground work wins quickly,
+// mining only takes cores back once they have stayed free for a while.
+const SHRINK_AFTER = 1;
+const GROW_AFTER = 3;
+
+// Grows or shrinks the number of active mining threads with system load.
+//
+// Each sample gives the cores the rest of the system is using (foreignCores).
+// With `active` threads mining, the scheduler shrinks to the free cores when
+// free < active - 0.5 and adds one thread when free > active + 1.5; inside
+// that band nothing changes, which together with the sample counts keeps it
+// from flapping. Growth is also held while loadavg1 exceeds the core count.
+//
+// apply(active, decision) changes the engine; decisions also go to onDecision.
+class IdleScheduler {
+  constructor({ min = 1, max, sampler, sampleMs = SAMPLE_MS, apply, onDecision }) {
+    this.sampler = sampler || new LoadSampler();
+    this.min = Math.max(0, min);
+    this.max = Math.max(this.min, max || this.sampler.cpus);
+    this.active = this.max;
+    this.sampleMs = sampleMs;
+    this.apply = apply;
+    this.onDecision = onDecision;
+    this.pressure = 0; // >0: samples in a row asking to shrink, <0: to grow
+    this.timer = null;
+  }
+
+  start() {
+    this.timer = setInterval(() => this.step(this.sampler.sample()), this.sampleMs);
+    this.timer.unref();
+    return this;
+  }
+
+  stop() {
+    if (this.timer) clearInterval(this.timer);
+    this.timer = null;
+  }
+
+  // Folds one load sample in; returns the decision when the active count changed.
+  step(load) {
+    const free = load.cpus - load.foreignCores;
+    let want = this.active;
+    if (free < this.active - 0.5) {
+      this.pressure = Math.max(1, this.pressure + 1);
+      if (this.pressure >= SHRINK_AFTER) want = Math.floor(free);
+    } else if (free > this.active + 1.5 && load.loadavg1 <= load.cpus) {
+      this.pressure = Math.min(-1, this.pressure - 1);
+      if (-this.pressure >= GROW_AFTER) want = this.active + 1;
+    } else {
+      this.pressure = 0;
+    }
+
+    want = Math.min(this.max, Math.max(this.min, want));
+    if (want === this.active) return null;
+    const decision = {
+      type: 'schedule',
+      from: this.active,
+      active: want,
+      reason: want < this.active ? 'system busy' : 'system idle',
+      load
+    };
+    this.active = want;
+    this.pressure = 0;
+    this.apply && this.apply(want, decision);
+    this.onDecision && this.onDecision(decision);
+    return decision;
+  }
+}
+
+module.exports = { IdleScheduler };
@@ -0,0 +1,40 @@
+// Job epoch shared between the pool and its workers. A worker's event loop is
+// busy for a whole slice, so a 'job' message would wait for the slice to
+// end; instead the pool bumps this counter and workers compare it between
+// small sub-batches, dropping the old template within a fraction of a ms.
+//
+// Layout: int32 epoch, then (8-byte aligned) the float64 time of the last
+// bump in ms since the epoch of performance.timeOrigin, for switch latency.
+const { performance } = require('perf_hooks');
+
+const BYTES = 16;
+
+function now() {
+  return performance.timeOrigin + performance.now();
+}
+
+class JobEpoch {
+  constructor(buffer) {
+    this.buffer = buffer || new SharedArrayBuffer(BYTES);
+    this.epoch = new Int32Array(this.buffer, 0, 1);
+    this.time = new Float64Array(this.buffer, 8, 1);
+  }
+
+  current() {
+    return Atomics.load(this.epoch, 0);
+  }
+
+  // The time is written before the bump, so a reader that sees the new
+  // epoch also sees when it started.
+  bump() {
+    this.time[0] = now();
+    return Atomics.add(this.epoch, 0, 1) + 1;
+  }
+
+  // Milliseconds since the last bump.
+  sinceBump() {
+    return now() - this.time[0];
+  }
+}
+
+module.exports = { JobEpoch, now };
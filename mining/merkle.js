@@ -0,0 +1,74 @@
+// Bitcoin-style merkle trees over 32-byte hashes in internal byte order
+// (sha256d output as is; RPC txids are the byte-reversed display form).
+// Odd levels duplicate their last node.
+//
+// Mining only ever changes the coinbase (leaf 0), so CoinbaseMerkle keeps
+// the coinbase branch, the siblings along the leftmost path, and recomputes
+// the root in log2(n) hashes per extranonce. Full builds hash a whole level
+// per hashMany call, which the native addon spreads over SIMD lanes/SHA-NI.
+const { hashMany } = require('./hash_many');
+const { sha256d } = require('./sha256');
+
+const HASH = 32;
+
+function toHash(h) {
+  if (Buffer.isBuffer(h) || h instanceof Uint8Array) return Buffer.from(h);
+  // Hex strings are taken as RPC (display order) txids.
+  return Buffer.from(String(h), 'hex').reverse();
+}
+
+// Concatenated hashes (n * 32 bytes) -> next level up. An odd level gets its
+// last node appended, so node pairs are exactly 64-byte strides.
+function hashLevel(level) {
+  const n = level.length / HASH;
+  const even = n % 2 ? Buffer.concat([level, level.subarray(level.length - HASH)]) : level;
+  return hashMany('sha256d', even, 2 * HASH, even.length / (2 * HASH));
+}
+
+function pack(hashes) {
+  return Buffer.concat(hashes.map(toHash));
+}
+
+// Root of a whole list of hashes (txids, coinbase first).
+function merkleRoot(hashes) {
+  if (!hashes.length) throw new RangeError('merkleRoot: no hashes');
+  let level = pack(hashes);
+  while (level.length > HASH) level = hashLevel(level);
+  return level;
+}
+
+// Siblings along leaf 0's path, from the other transactions alone: at every
+// level the sibling is the first node that does not depend on leaf 0, and
+// the next level's independent nodes are the pairs after it.
+function coinbaseBranch(txids) {
+  const branch = [];
+  let rest = pack(txids);
+  while (rest.length) {
+    branch.push(Buffer.from(rest.subarray(0, HASH)));
+    const tail = rest.subarray(HASH);
+    rest = tail.length ? hashLevel(tail) : tail;
+  }
+  return branch;
+}
+
+// Root for leaf 0 given its branch: one sha256d per level.
+function rootFromBranch(leaf, branch) {
+  let node = toHash(leaf);
+  for (const sibling of branch) node = sha256d(Buffer.concat([node, sibling]));
+  return node;
+}
+
+// Coinbase branch of a block template, computed once per template.
+class CoinbaseMerkle {
+  // txids: every transaction except the coinbase, in block order.
+  constructor(txids = []) {
+    this.branch = coinbaseBranch(txids);
+  }
+
+  // Merkle root for a serialized coinbase.
+  rootFor(coinbase) {
+    return rootFromBranch(sha256d(coinbase), this.branch);
+  }
+}
+
+module.exports = { merkleRoot, coinbaseBranch, rootFromBranch, CoinbaseMerkle };
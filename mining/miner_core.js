@@ -0,0 +1,339 @@
+const { sha256d } = require('./sha256');
+const { bitsToTarget } = require('./target');
+const { WorkerPool } = require('./worker_pool');
+const { TemplateRoller } = require('./template_roller');
+const { CoinbaseMerkle, rootFromBranch } = require('./merkle');
+const { getCoin } = require('./coins');
+const { BatchSizer } = require('./batch_sizer');
+const { HashrateEstimator } = require('./hashrate');
+const { DutyCycle, afterSlice, cancelSlice } = require('./throttle');
+const { IdleScheduler } = require('./idle_scheduler');
+const { SharedStats } = require('./shared_stats');
+
+// The in-process loop shares the event loop with IPC, so its slices stay short.
+const IN_PROCESS_SLICE_MS = 8;
+// First in-process batch for sha256d, divided by the algorithm's cost; later
+// batches follow the measured slice time.
+const IN_PROCESS_BATCH = 5000;
+
+// nTime of the fixed header used in seeded (deterministic) runs.
+const SEEDED_TIME = 1700000000;
+
+function seeded(options) {
+  return options.seed !== undefined && options.seed !== null && options.seed !== '';
+}
+
+// 80-byte header: version | prevHash | merkleRoot | nTime | nBits | nonce
+function buildHeader({ version = 0x20000000, prevHash, merkleRoot, time, bits, nonce = 0 }) {
+  const header = Buffer.alloc(80);
+  header.writeUInt32LE(version >>> 0, 0);
+  if (prevHash) Buffer.from(prevHash).copy(header, 4, 0, 32);
+  if (merkleRoot) Buffer.from(merkleRoot).copy(header, 36, 0, 32);
+  header.writeUInt32LE(time >>> 0, 68);
+  header.writeUInt32LE(bits >>> 0, 72);
+  header.writeUInt32LE(nonce >>> 0, 76);
+  return header;
+}
+
+class MinerManager {
+  constructor() {
+    this.miners = new Map();
+    this.counter = 1;
+  }
+
+  // options.coin picks the PoW algorithm and default share bits from config/coins.json.
+  // options.intensity (0-100, default 100) is the share of CPU time spent hashing.
+  // options.idle ({ minThreads, maxThreads } or true) lets the worker pool grow
+  // and shrink with system load; its decisions go to onEvent.
+  // options.affinity pins each pool worker to its own core (see topology.js).
+  // options.seed makes the run reproducible: fixed nTime, seeded nonce order
+  // (SeededScheduler) on the worker pool, and a 'solution' event with the first
+  // share in that order, which is the same for every run and thread count.
+  // A seed cannot be combined with options.idle: a parked worker's chunk
+  // would hold back the solution, which waits for every earlier chunk.
+  start(options, onStats, onEvent) {
+    if (seeded(options) && options.idle) throw new Error('A seeded run cannot use idle scheduling');
+    const coin = getCoin(options.coin);
+    const algo = coin.pow;
+    const id = this.counter++;
+    const state = {
+      id,
+      options,
+      running: true,
+      hashrate: 0,
+      shares: 0,
+      accepted: 0,
+      rejected: 0,
+      uptimeSec: 0,
+      algo,
+      duty: new DutyCycle(options.intensity ?? 100),
+      switches: 0
+    };
+
+    // Easy local share target so the demo engine finds real shares.
+    state.bits = options.bits ?? coin.shareBits;
+    state.merkleRoot = sha256d(`${options.coin}|${options.address}`);
+    // options.job (see newJob) starts on a real template, e.g. a pool's.
+    const { header, roller } = this._template(state, options.job || {});
+    const target = state.target;
+
+    // Solo demo has no pool to judge shares; workers only report hashes that
+    // meet the target, so those count as accepted. With options.submit
+    // (found -> Promise<boolean>) shares go out at once and the pool's answer
+    // counts instead; found.tag is the job (options.job or newJob's) the
+    // share was mined on. Shares of a job replaced by a clean one are
+    // rejected as stale.
+    state.job = options.job || null;
+    const onFound = (f) => {
+      if (f.stale) {
+        state.rejected += 1;
+      } else if (options.submit) {
+        // A submit that fails outright (connection gone) counts as rejected.
+        options.submit(f).then((ok) => {
+          if (ok) state.accepted += 1;
+          else state.rejected += 1;
+        }, () => {
+          state.rejected += 1;
+        });
+      } else {
+        state.accepted += 1;
+      }
+    };
+
+    // threads: 0 keeps the old single-threaded loop on this event loop.
+    const inProcess = !seeded(options) &&
+      options.threads !== undefined && options.threads !== '' && Number(options.threads) === 0;
+    if (inProcess) this._startInProcess(state, header, roller, target, onFound);
+    else this._startPool(state, header, roller, target, onFound, onEvent);
+    if (state.pool && options.idle) this._startIdle(state, options.idle, onEvent);
+
+    const startTime = Date.now();
+    const estimator = new HashrateEstimator();
+    let counted = 0;
+    state._tick = setInterval(() => {
+      const now = Date.now();
+      // Counters are read straight from the shared slots; nothing is messaged.
+      const totals = state.stats.total();
+      estimator.addHashes(totals.hashes - counted);
+      counted = totals.hashes;
+      state.shares = totals.shares;
+      const { hashrates, totalHashes } = estimator.snapshot();
+      // `hashrate` is the 10 s average; the longer windows smooth out bursts.
+      state.hashrate = hashrates['10s'];
+      state.uptimeSec = Math.floor((now - startTime) / 1000);
+      onStats && onStats({
+        hashrate: state.hashrate,
+        hashrates,
+        totalHashes,
+        shares: state.shares,
+        bestDifficulty: totals.bestDifficulty,
+        accepted: state.accepted,
+        rejected: state.rejected,
+        uptimeSec: state.uptimeSec,
+        threads: state.pool ? state.pool.size : 0,
+        activeThreads: state.pool ? state.pool.active : 0,
+        algorithm: algo.name,
+        intensity: state.duty.intensity,
+        kernel: algo.impl,
+        batch: state.pool ? state.pool.batchSize() : state.sizer.size,
+        // Job switches, hashes spent on replaced jobs after the switch, and
+        // how long the slowest worker took to drop the last one.
+        jobs: {
+          switches: state.switches,
+          wastedHashes: totals.wastedHashes,
+          lastSwitchMs: +totals.switchMs.toFixed(3)
+        },
+        workers: state.pool ? state.pool.workerStats() : []
+      });
+    }, 1000);
+
+    this.miners.set(id, state);
+    return id;
+  }
+
+  _startPool(state, header, roller, target, onFound, onEvent) {
+    state.pool = new WorkerPool({
+      threads: state.options.threads,
+      intensity: state.duty.intensity,
+      affinity: !!state.options.affinity
+    });
+    state.stats = state.pool.stats;
+    if (!seeded(state.options)) {
+      state.pool.start({ header, target, roller, algorithm: state.algo.name, tag: state.job }, { onFound });
+      return;
+    }
+    // The seeded scheduler settles the solution once every chunk before it is done.
+    const settle = (solution) => {
+      if (!solution || state.solution) return;
+      state.solution = solution;
+      const { nonce, hash, template, hashes } = solution;
+      onEvent && onEvent({ type: 'solution', id: state.id, seed: state.options.seed, nonce, hash, template, hashes });
+    };
+    const pool = state.pool;
+    pool.start({ header, target, roller, algorithm: state.algo.name, seed: state.options.seed }, {
+      onFound: (f) => {
+        onFound(f);
+        if (!f.stale) settle(pool.scheduler.offer({ ...f, template: f.template.index }));
+      },
+      onChunkDone: (worker, template, start) => settle(pool.scheduler.complete(template, start))
+    });
+  }
+
+  _startIdle(state, idle, onEvent) {
+    const { minThreads = 1, maxThreads } = idle === true ? {} : idle;
+    const pool = state.pool;
+    state.idle = new IdleScheduler({
+      min: Number(minThreads),
+      max: Math.min(pool.size, Number(maxThreads) || pool.size),
+      apply: (n) => pool.setActive(n),
+      onDecision: (d) => onEvent && onEvent({ ...d, id: state.id })
+    });
+    pool.setActive(state.idle.active);
+    state.idle.start();
+  }
+
+  _startInProcess(state, header, first, target, onFound) {
+    const { algo } = state;
+    const sizer = state.sizer = new BatchSizer({
+      targetMs: IN_PROCESS_SLICE_MS,
+      initial: IN_PROCESS_BATCH / algo.cost.relative
+    });
+    let roller = first || new TemplateRoller({ header });
+    let search = algo.createSearch(header, target, roller.midstate);
+    // One slot, written the same way pool workers write theirs.
+    const stats = state.stats = new SharedStats(1);
+    // Runs between slices (this loop owns the thread), so nothing is wasted.
+    state._switch = (next, nextRoller) => {
+      roller = nextRoller || new TemplateRoller({ header: next });
+      search = algo.createSearch(next, state.target, roller.midstate);
+      stats.addSwitch(0, 0, 0);
+    };
+
+    const loop = () => {
+      state._slice = null;
+      if (!state.running || state.duty.paused) return;
+      const batch = sizer.start();
+      let remaining = batch;
+      while (remaining > 0) {
+        if (search.exhausted) {
+          const t = roller.next();
+          search = algo.createSearch(t.header, state.target, t.midstate);
+        }
+        const res = search.scan(remaining);
+        remaining -= res.hashes;
+        if (res.found) {
+          stats.addShare(0, res.hash);
+          onFound({ header: search.header, nonce: search.header.readUInt32LE(76), template: roller.current(), tag: state.job });
+        }
+      }
+      stats.addHashes(0, batch);
+      state._slice = afterSlice(state.duty, sizer.done(batch), loop);
+    };
+    state._resume = loop;
+
+    loop();
+  }
+
+  stop(id) {
+    const state = this.miners.get(id);
+    if (state) {
+      state.running = false;
+      cancelSlice(state._slice);
+      if (state._tick) clearInterval(state._tick);
+      if (state.idle) state.idle.stop();
+      if (state.pool) state.pool.stop();
+      this.miners.delete(id);
+    }
+  }
+
+  // Changes a running miner's intensity in place; the search and its stats carry on.
+  setIntensity(id, intensity) {
+    const state = this.miners.get(id);
+    if (!state) return { ok: false, error: 'Unknown miner' };
+    state.duty.set(intensity);
+    if (state.pool) {
+      state.pool.setIntensity(state.duty.intensity);
+    } else {
+      cancelSlice(state._slice);
+      state._resume();
+    }
+    return { ok: true, intensity: state.duty.intensity };
+  }
+
+  // Moves a running miner onto a new block template (new prevHash, or a pool
+  // job) without restarting it. job: { prevHash, merkleRoot, bits, version,
+  // time, clean }; merkleRoot and bits default to the current job's. With
+  // clean: false (a pool notify without clean_jobs) shares of the previous
+  // jobs still found after the switch are submitted, not dropped.
+  //
+  // Instead of a merkleRoot a job may give its coinbase and either the other
+  // transactions' txids or a ready merkleBranch (Buffers, as pools send it).
+  // The branch is built once here; with coinbaseFor (extranonce -> coinbase)
+  // pool workers roll the extranonce at log2(n) hashes per template. A job
+  // target (a pool's share target) overrides the one from bits.
+  newJob(id, job = {}) {
+    const state = this.miners.get(id);
+    if (!state) return { ok: false, error: 'Unknown miner' };
+    const { header, roller } = this._template(state, job);
+    state.switches += 1;
+    state.solution = null;
+    state.job = job;
+    if (state.pool) {
+      state.pool.switchJob({ header, target: state.target, roller, seed: state.options.seed, clean: job.clean !== false, tag: job });
+    } else {
+      state._switch(header, roller);
+    }
+    return { ok: true, switches: state.switches };
+  }
+
+  // Header for a job (see newJob), plus a roller when it has coinbaseFor.
+  // Updates the miner's bits, target and merkle root.
+  _template(state, job) {
+    state.bits = job.bits ?? state.bits;
+    state.target = job.target ? Buffer.from(job.target) : bitsToTarget(state.bits);
+    let branch = null;
+    if (job.coinbase || job.coinbaseFor) {
+      branch = job.merkleBranch
+        ? job.merkleBranch.map(h => Buffer.from(h))
+        : new CoinbaseMerkle(job.transactions || []).branch;
+      const coinbase = job.coinbase || job.coinbaseFor(0);
+      state.merkleRoot = rootFromBranch(sha256d(coinbase), branch);
+    } else if (job.merkleRoot) {
+      state.merkleRoot = job.merkleRoot;
+    }
+    const header = buildHeader({
+      version: job.version,
+      prevHash: job.prevHash,
+      merkleRoot: state.merkleRoot,
+      time: job.time ?? (seeded(state.options) ? SEEDED_TIME : Math.floor(Date.now() / 1000)),
+      bits: state.bits
+    });
+    const roller = branch && job.coinbaseFor
+      ? new TemplateRoller({ header, coinbaseFor: job.coinbaseFor, merkleBranch: branch, timeWindow: job.timeWindow })
+      : undefined;
+    return { header, roller };
+  }
+
+  // Worker placement of every running miner, for diagnostics.
+  placement() {
+    return [...this.miners.values()].map(state => ({
+      id: state.id,
+      algorithm: state.algo.name,
+      affinity: !!state.options.affinity,
+      workers: state.pool ? state.pool.placement() : []
+    }));
+  }
+}
+
+const manager = new MinerManager();
+
+module.exports = {
+  start: (options, onStats, onEvent) => manager.start(options, onStats, onEvent),
+  stop: (id) => manager.stop(id),
+  setIntensity: (id, intensity) => manager.setIntensity(id, intensity),
+  newJob: (id, job) => manager.newJob(id, job),
+  placement: () => manager.placement(),
+  buildHeader,
+  sha256d,
+  SEEDED_TIME
+};
@@ -0,0 +1,195 @@
+// worker_threads entry for the built-in engine. The pool hands each worker a
+// nonce chunk of one header template at a time and always keeps one more
+// queued, so a worker never waits when its current chunk runs dry. Each
+// request for work reports how long the previous chunk took. Below 100%
+// intensity the worker sleeps between slices (see throttle.js). Hashes, shares
+// and slice size go to this worker's slot in the shared stats buffer.
+//
+// A slice is scanned in sub-batches of about CHECK_MS; between them the worker
+// checks the shared job epoch and drops the old template as soon as the pool
+// switches jobs, counting the hashes spent on it after the switch as wasted.
+const { parentPort, workerData } = require('worker_threads');
+const pow = require('./pow');
+const { BatchSizer } = require('./batch_sizer');
+const { DutyCycle, afterSlice, cancelSlice } = require('./throttle');
+const topology = require('./topology');
+const { SharedStats } = require('./shared_stats');
+const { JobEpoch, now } = require('./job_epoch');
+
+// Pin before any per-worker state exists: with Linux's first-touch policy the
+// search buffers this thread allocates later land on its own NUMA node.
+const pinned = workerData.cpu !== null && workerData.cpu !== undefined && topology.pinCurrentThread(workerData.cpu);
+parentPort.postMessage({
+  type: 'placement',
+  worker: workerData.index,
+  cpu: workerData.cpu ?? null,
+  node: workerData.node ?? null,
+  pinned,
+  runningOn: topology.currentCpu()
+});
+
+// Workers own their event loop, so slices can be much longer than in-process;
+// they only need to stay responsive to 'work' and 'stop' messages.
+const SLICE_MS = 50;
+const INITIAL_SLICE = 20000;
+const CHECK_MS = 0.25;
+
+const slot = workerData.index;
+const stats = new SharedStats(workerData.slots, workerData.stats);
+const jobEpoch = new JobEpoch(workerData.epoch);
+
+let target = null;
+let algo = null;
+let epoch = -1;
+let wasted = 0;
+let sizer = null;
+const duty = new DutyCycle(workerData.intensity);
+let pending = null;
+let idleBusyMs = 0;
+// Cleared by the idle-aware scheduler to park this worker.
+let active = true;
+let search = null;
+let current = null;
+const queue = [];
+let running = false;
+let looping = false;
+let unitHashes = 0;
+let unitStarted = 0n;
+// Report of a unit that ran dry before the next one arrived, sent with the
+// next request for work.
+let finished = null;
+
+// Switches to the queued unit and asks for the one after it.
+function advance() {
+  const now = process.hrtime.bigint();
+  const last = current ? {
+    template: current.template,
+    start: current.start,
+    end: current.end,
+    hashes: unitHashes,
+    ms: Number(now - unitStarted) / 1e6
+  } : finished;
+  finished = null;
+  current = queue.shift() || null;
+  if (!current) {
+    finished = last;
+    return false;
+  }
+  // Units of a multi-search pool carry their own target and algorithm.
+  const unitAlgo = current.algorithm ? pow.get(current.algorithm) : algo;
+  const unitTarget = current.target ? Buffer.from(current.target) : target;
+  search = unitAlgo.createSearch(Buffer.from(current.header), unitTarget, current.midstate);
+  search.setRange(current.start, current.end);
+  unitHashes = 0;
+  unitStarted = now;
+  parentPort.postMessage({ type: 'need-work', worker: workerData.index, epoch, last });
+  return true;
+}
+
+// Drops the current job's work; the pool has already posted the next 'job'.
+// `hashes` were done in the sub-batch that started `subMs` ago, and the part
+// of it after the switch is counted as wasted.
+function abandon(hashes, subMs) {
+  const late = Math.min(1, jobEpoch.sinceBump() / Math.max(subMs, 1e-3));
+  wasted += Math.round(hashes * late);
+  current = null;
+  search = null;
+  finished = null;
+  queue.length = 0;
+}
+
+function loop() {
+  looping = false;
+  pending = null;
+  if (!running) return;
+  const batch = sizer.start();
+  const sub = Math.max(1, Math.round(batch * CHECK_MS / sizer.targetMs));
+  let remaining = batch;
+  let lastHashes = 0;
+  let subStarted = now();
+  while (remaining > 0) {
+    if (jobEpoch.current() !== epoch) {
+      abandon(lastHashes, now() - subStarted);
+      break;
+    }
+    if ((!search || search.exhausted) && !advance()) break;
+    subStarted = now();
+    const res = search.scan(Math.min(sub, remaining));
+    lastHashes = res.hashes;
+    remaining -= res.hashes;
+    unitHashes += res.hashes;
+    if (res.found) {
+      stats.addShare(slot, res.hash);
+      parentPort.postMessage({
+        type: 'found',
+        worker: workerData.index,
+        epoch,
+        template: current.template,
+        nonce: res.nonce,
+        hash: res.hash,
+        header: search.header
+      });
+    }
+  }
+  stats.addHashes(slot, batch - remaining);
+  const busyMs = sizer.done(batch - remaining);
+  stats.setBatch(slot, sizer.size);
+  // With nothing queued the worker idles until the next 'work' message; the
+  // sleep owed for this slice is taken when that arrives.
+  if (current) schedule(busyMs);
+  else idleBusyMs = busyMs;
+}
+
+// Compute per slice shrinks with intensity so one slice plus its sleep stays
+// about SLICE_MS of wall time, well inside a scheduler chunk.
+function sliceTarget() {
+  return SLICE_MS * Math.max(1, duty.intensity) / 100;
+}
+
+// Queues the next slice, after the duty-cycle sleep owed for busyMs of compute.
+function schedule(busyMs = 0) {
+  if (looping || duty.paused || !active) return;
+  looping = true;
+  idleBusyMs = 0;
+  pending = afterSlice(duty, busyMs, loop);
+}
+
+parentPort.on('message', (msg) => {
+  if (msg.type === 'job') {
+    // A switch (not the first job): record how long the old job kept this
+    // worker and what it wasted, then start over on the new one.
+    if (epoch >= 0) {
+      stats.addSwitch(slot, wasted, jobEpoch.sinceBump());
+      wasted = 0;
+      current = null;
+      search = null;
+      finished = null;
+      queue.length = 0;
+    }
+    epoch = msg.epoch;
+    target = msg.target ? Buffer.from(msg.target) : null;
+    if (!algo || algo.name !== msg.algorithm) {
+      algo = pow.get(msg.algorithm);
+      sizer = new BatchSizer({ targetMs: sliceTarget(), initial: INITIAL_SLICE / algo.cost.relative });
+    }
+    running = true;
+  } else if (msg.type === 'work') {
+    if (msg.epoch !== epoch) return; // posted before a job switch
+    queue.push(msg);
+    if (!current) schedule(idleBusyMs);
+  } else if (msg.type === 'intensity' || msg.type === 'active') {
+    if (msg.type === 'active') active = msg.value;
+    else duty.set(msg.value);
+    if (sizer) sizer.targetMs = sliceTarget();
+    if (duty.paused || !active) {
+      cancelSlice(pending);
+      looping = false;
+    } else if (current || queue.length) {
+      schedule();
+    }
+  } else if (msg.type === 'stop') {
+    running = false;
+    cancelSlice(pending);
+    parentPort.close();
+  }
+});
@@ -0,0 +1,344 @@
+// Stratum pools on localhost for offline tests and demos: MockPool speaks v1,
+// MockPoolV2 the v2 binary protocol. Jobs have a random prevhash and merkle
+// branch, the difficulty is low enough for a CPU, and every submitted share is
+// really checked: coinbase, merkle root and header are rebuilt from the job
+// and hashed against the share target.
+//
+//   node mining/mock_pool.js [port] [difficulty] [v1|v2]
+const net = require('net');
+const crypto = require('crypto');
+const { EventEmitter } = require('events');
+const { sha256d } = require('./sha256');
+const { rootFromBranch } = require('./merkle');
+const { meetsTarget, hashToHex } = require('./target');
+const pow = require('./pow');
+const { difficultyToTarget, hex32 } = require('./pool_mining');
+const { FrameDecoder, encode, targetToWire, VERSION } = require('./stratum_v2');
+
+const EXTRANONCE1_SIZE = 4;
+// Jobs kept for late shares (until a clean job drops them).
+const JOB_HISTORY = 4;
+
+class MockPool extends EventEmitter {
+  // difficulty: share difficulty (2^-16 is ~65k hashes per share)
+  // bits:       nBits put in jobs (only carried, never checked)
+  constructor({ difficulty = 1 / 65536, extranonce2Size = 4, algorithm = 'sha256d', bits = 0x1d00ffff } = {}) {
+    super();
+    this.difficulty = difficulty;
+    this.extranonce2Size = extranonce2Size;
+    this.algo = pow.get(algorithm);
+    this.bits = bits;
+    this.clients = new Set();
+    this.jobs = new Map();
+    this.jobCounter = 0;
+    this.nextExtranonce1 = 1;
+    this.seen = new Set();
+    this.stats = { submitted: 0, accepted: 0, rejected: 0, stale: 0, duplicate: 0 };
+    this.job = this._makeJob(true);
+    this.server = net.createServer(socket => this._onConnection(socket));
+  }
+
+  listen(port = 0, host = '127.0.0.1') {
+    return new Promise((resolve) => {
+      this.server.listen(port, host, () => resolve(this.server.address().port));
+    });
+  }
+
+  close() {
+    for (const c of this.clients) c.socket.destroy();
+    return new Promise(resolve => this.server.close(() => resolve()));
+  }
+
+  // Coinbase split around the extranonces: height push, then en1 | en2 in
+  // the scriptSig, then a tag push, sequence, one output and locktime.
+  _makeJob(clean) {
+    const id = (++this.jobCounter).toString(16);
+    const height = Buffer.from([0x03, this.jobCounter & 0xff, (this.jobCounter >> 8) & 0xff, 0]);
+    const tag = Buffer.from('mock-pool', 'utf8');
+    const scriptLen = height.length + EXTRANONCE1_SIZE + this.extranonce2Size + 1 + tag.length;
+    const prevout = Buffer.concat([Buffer.alloc(32), Buffer.from('ffffffff', 'hex')]);
+    const coinb1 = Buffer.concat([Buffer.from('0100000001', 'hex'), prevout, Buffer.from([scriptLen]), height]);
+    const value = Buffer.alloc(8);
+    value.writeBigUInt64LE(5000000000n);
+    const coinb2 = Buffer.concat([
+      Buffer.from([tag.length]), tag, Buffer.from('ffffffff', 'hex'),
+      Buffer.from([1]), value, Buffer.from([1, 0x51]), Buffer.alloc(4)
+    ]);
+    const job = {
+      id,
+      prevHash: crypto.randomBytes(32),
+      coinb1,
+      coinb2,
+      branch: [crypto.randomBytes(32), crypto.randomBytes(32)],
+      version: 0x20000000,
+      time: Math.floor(Date.now() / 1000),
+      target: difficultyToTarget(this.difficulty),
+      clean
+    };
+    if (clean) this.jobs.clear();
+    this.jobs.set(id, job);
+    if (this.jobs.size > JOB_HISTORY) this.jobs.delete(this.jobs.keys().next().value);
+    return job;
+  }
+
+  _notifyParams(job) {
+    return [
+      job.id, Buffer.from(job.prevHash).swap32().toString('hex'),
+      job.coinb1.toString('hex'), job.coinb2.toString('hex'),
+      job.branch.map(h => h.toString('hex')),
+      hex32(job.version), hex32(this.bits), hex32(job.time), job.clean
+    ];
+  }
+
+  _send(client, msg) {
+    client.socket.write(`${JSON.stringify(msg)}\n`);
+  }
+
+  // Sends a new job to every client (clean drops shares of older jobs).
+  notify(clean = true) {
+    this.job = this._makeJob(clean);
+    for (const c of this.clients) {
+      if (c.authorized) this._send(c, { id: null, method: 'mining.notify', params: this._notifyParams(this.job) });
+    }
+    return this.job.id;
+  }
+
+  // Takes effect from the next job, as in Stratum.
+  setDifficulty(difficulty) {
+    this.difficulty = difficulty;
+    for (const c of this.clients) {
+      if (c.authorized) this._send(c, { id: null, method: 'mining.set_difficulty', params: [difficulty] });
+    }
+  }
+
+  // New extranonce1 for every client (mining.set_extranonce), from the next
+  // job on.
+  setExtranonce() {
+    for (const c of this.clients) {
+      if (!c.authorized) continue;
+      c.extranonce1 = Buffer.alloc(EXTRANONCE1_SIZE);
+      c.extranonce1.writeUInt32BE(this.nextExtranonce1++);
+      this._send(c, { id: null, method: 'mining.set_extranonce', params: [c.extranonce1.toString('hex'), this.extranonce2Size] });
+    }
+  }
+
+  _onConnection(socket) {
+    const extranonce1 = Buffer.alloc(EXTRANONCE1_SIZE);
+    extranonce1.writeUInt32BE(this.nextExtranonce1++);
+    const client = { socket, extranonce1, authorized: false };
+    this.clients.add(client);
+    socket.setNoDelay(true);
+    socket.setEncoding('utf8');
+    let buffer = '';
+    socket.on('data', (chunk) => {
+      buffer += chunk;
+      let nl;
+      while ((nl = buffer.indexOf('\n')) >= 0) {
+        const line = buffer.slice(0, nl).trim();
+        buffer = buffer.slice(nl + 1);
+        if (!line) continue;
+        try {
+          this._onRequest(client, JSON.parse(line));
+        } catch (e) {
+          socket.destroy();
+          return;
+        }
+      }
+    });
+    socket.on('error', () => {});
+    socket.on('close', () => this.clients.delete(client));
+  }
+
+  _onRequest(client, { id, method, params }) {
+    if (method === 'mining.subscribe') {
+      this._send(client, {
+        id,
+        result: [[['mining.notify', client.extranonce1.toString('hex')]], client.extranonce1.toString('hex'), this.extranonce2Size],
+        error: null
+      });
+    } else if (method === 'mining.authorize') {
+      client.authorized = true;
+      client.user = params[0];
+      this._send(client, { id, result: true, error: null });
+      this._send(client, { id: null, method: 'mining.set_difficulty', params: [this.difficulty] });
+      this._send(client, { id: null, method: 'mining.notify', params: this._notifyParams(this.job) });
+    } else if (method === 'mining.submit') {
+      const error = this._check(client, params);
+      this._send(client, { id, result: !error, error });
+    } else {
+      this._send(client, { id, result: null, error: [20, `Unknown method ${method}`, null] });
+    }
+  }
+
+  // Null for a good share, else a Stratum error triple.
+  _check(client, [user, jobId, en2, ntime, nonce]) {
+    const extranonce = Buffer.concat([client.extranonce1, Buffer.from(en2, 'hex')]);
+    const error = this._verify(user, jobId, extranonce, parseInt(ntime, 16), parseInt(nonce, 16), null);
+    return error && [error.code, error.message, null];
+  }
+
+  // Merkle root of a job for a full extranonce (extranonce1 | extranonce2).
+  _merkleRoot(job, extranonce) {
+    const coinbase = Buffer.concat([job.coinb1, extranonce, job.coinb2]);
+    return rootFromBranch(sha256d(coinbase), job.branch);
+  }
+
+  // Checks a share of job jobId (hex id); null when it is good, else
+  // { code, message }. version null means the job's.
+  _verify(user, jobId, extranonce, ntime, nonce, version) {
+    this.stats.submitted++;
+    const reject = (kind, code, message) => {
+      this.stats[kind]++;
+      this.emit('share', { user, jobId, accepted: false, error: message });
+      return { code, message };
+    };
+    const job = this.jobs.get(jobId);
+    if (!job) return reject('stale', 21, 'Job not found');
+    const key = `${jobId}:${extranonce.toString('hex')}:${ntime}:${nonce}:${version}`;
+    if (this.seen.has(key)) return reject('duplicate', 22, 'Duplicate share');
+    this.seen.add(key);
+
+    const header = Buffer.alloc(80);
+    header.writeUInt32LE((version ?? job.version) >>> 0, 0);
+    job.prevHash.copy(header, 4);
+    this._merkleRoot(job, extranonce).copy(header, 36);
+    header.writeUInt32LE(ntime >>> 0, 68);
+    header.writeUInt32LE(this.bits, 72);
+    header.writeUInt32LE(nonce >>> 0, 76);
+    const hash = this.algo.hash(header);
+    if (!meetsTarget(hash, job.target)) return reject('rejected', 23, 'Low difficulty share');
+    this.stats.accepted++;
+    this.emit('share', { user, jobId, accepted: true, hash: hashToHex(hash) });
+    return null;
+  }
+}
+
+// Stratum v2 test server: SetupConnection, then one standard or extended
+// channel per connection. Standard channels get the whole extranonce from
+// the pool and a ready merkle root (header-only mining). Extended channels
+// get the coinbase halves and merkle path and roll extranonce2 themselves.
+// Accepted shares are acknowledged in batches: one SubmitShares.Success per
+// event-loop turn covers every share that arrived in it.
+class MockPoolV2 extends MockPool {
+  _onConnection(socket) {
+    const extranonce1 = Buffer.alloc(EXTRANONCE1_SIZE);
+    extranonce1.writeUInt32BE(this.nextExtranonce1++);
+    const client = { socket, extranonce1, channel: null, acks: null };
+    this.clients.add(client);
+    socket.setNoDelay(true);
+    const decoder = new FrameDecoder();
+    socket.on('data', (chunk) => {
+      let frames;
+      try {
+        frames = decoder.push(chunk);
+      } catch (e) {
+        socket.destroy();
+        return;
+      }
+      for (const { name, msg } of frames) this._onFrame(client, name, msg);
+    });
+    socket.on('error', () => {});
+    socket.on('close', () => this.clients.delete(client));
+  }
+
+  _send(client, name, msg) {
+    client.socket.write(encode(name, msg));
+  }
+
+  _onFrame(client, name, msg) {
+    if (name === 'SetupConnection') {
+      this._send(client, 'SetupConnectionSuccess', { usedVersion: VERSION, flags: 0 });
+    } else if (name === 'OpenStandardMiningChannel' || name === 'OpenExtendedMiningChannel') {
+      const extended = name === 'OpenExtendedMiningChannel';
+      const channelId = client.extranonce1.readUInt32BE(0);
+      client.user = msg.userIdentity;
+      client.channel = { id: channelId, extended };
+      const target = targetToWire(difficultyToTarget(this.difficulty));
+      if (extended) {
+        this._send(client, 'OpenExtendedMiningChannelSuccess', {
+          requestId: msg.requestId, channelId, target, extranonceSize: this.extranonce2Size, extranoncePrefix: client.extranonce1
+        });
+      } else {
+        // The pool picks the rest of the extranonce for a standard channel.
+        client.channel.extranonce = Buffer.concat([client.extranonce1, Buffer.alloc(this.extranonce2Size)]);
+        this._send(client, 'OpenStandardMiningChannelSuccess', {
+          requestId: msg.requestId, channelId, target, extranoncePrefix: client.channel.extranonce, groupChannelId: 0
+        });
+      }
+      this._sendJob(client, this.job);
+    } else if (name === 'SubmitSharesStandard' || name === 'SubmitSharesExtended') {
+      const extranonce = client.channel.extended
+        ? Buffer.concat([client.extranonce1, msg.extranonce])
+        : client.channel.extranonce;
+      const error = this._verify(client.user, msg.jobId.toString(16), extranonce, msg.ntime, msg.nonce, msg.version);
+      if (error) {
+        this._send(client, 'SubmitSharesError', {
+          channelId: msg.channelId, sequenceNumber: msg.sequenceNumber, errorCode: error.message
+        });
+      } else {
+        this._ack(client, msg.sequenceNumber);
+      }
+    }
+  }
+
+  _ack(client, sequenceNumber) {
+    if (!client.acks) {
+      client.acks = { count: 0, last: 0 };
+      setImmediate(() => {
+        const { count, last } = client.acks;
+        client.acks = null;
+        if (client.socket.destroyed) return;
+        this._send(client, 'SubmitSharesSuccess', {
+          channelId: client.channel.id, lastSequenceNumber: last, newSubmitsAcceptedCount: count, newSharesSum: count
+        });
+      });
+    }
+    client.acks.count++;
+    client.acks.last = sequenceNumber;
+  }
+
+  // A future job for the channel, then the prevhash that activates it.
+  _sendJob(client, job) {
+    const ch = client.channel;
+    const jobId = parseInt(job.id, 16);
+    if (ch.extended) {
+      this._send(client, 'NewExtendedMiningJob', {
+        channelId: ch.id, jobId, minNtime: null, version: job.version, versionRollingAllowed: false,
+        merklePath: job.branch, coinbaseTxPrefix: job.coinb1, coinbaseTxSuffix: job.coinb2
+      });
+    } else {
+      this._send(client, 'NewMiningJob', {
+        channelId: ch.id, jobId, minNtime: null, version: job.version, merkleRoot: this._merkleRoot(job, ch.extranonce)
+      });
+    }
+    this._send(client, 'SetNewPrevHash', {
+      channelId: ch.id, jobId, prevHash: job.prevHash, minNtime: job.time, nbits: this.bits
+    });
+  }
+
+  // Every v2 job is a new block (new prevhash), so older jobs are dropped.
+  notify() {
+    this.job = this._makeJob(true);
+    for (const c of this.clients) if (c.channel) this._sendJob(c, this.job);
+    return this.job.id;
+  }
+
+  setDifficulty(difficulty) {
+    this.difficulty = difficulty;
+    const maximumTarget = targetToWire(difficultyToTarget(difficulty));
+    for (const c of this.clients) if (c.channel) this._send(c, 'SetTarget', { channelId: c.channel.id, maximumTarget });
+  }
+}
+
+if (require.main === module) {
+  const v2 = process.argv[4] === 'v2';
+  const Pool = v2 ? MockPoolV2 : MockPool;
+  const pool = new Pool({ difficulty: process.argv[3] ? Number(process.argv[3]) : undefined });
+  pool.on('share', s => console.log(JSON.stringify(s)));
+  pool.listen(Number(process.argv[2] || 3333)).then((port) => {
+    console.log(`mock pool on ${v2 ? 'stratum2' : 'stratum'}+tcp://127.0.0.1:${port}`);
+    setInterval(() => pool.notify(false), 30000);
+  });
+}
+
+module.exports = { MockPool, MockPoolV2 };
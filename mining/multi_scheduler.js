@@ -0,0 +1,137 @@
+const { NonceScheduler } = require('./scheduler');
+const pow = require('./pow');
+
+const RATE_ALPHA = 0.3;
+
+// Expected hashes to meet a 32-byte big-endian target: 2^256 / (target + 1).
+function expectedHashes(target) {
+  const t = BigInt(`0x${Buffer.from(target).toString('hex')}`);
+  return Number((1n << 256n) / (t + 1n));
+}
+
+// Several independent searches (e.g. the genesis blocks of mainnet, testnet
+// and regtest) interleaved on one worker pool, with the NonceScheduler
+// interface WorkerPool expects.
+//
+// Each search keeps its own NonceScheduler. Chunks go to the unsolved search
+// that has been handed the smallest share of its expected work so far, so
+// every search progresses in proportion to its difficulty and no core idles
+// while any search is left. remove() retires a solved search and its share
+// of the pool flows to the rest on the very next chunk.
+//
+// Template indices are renumbered into one global space; each template also
+// carries the search's key, target and algorithm, which WorkerPool forwards
+// with every work unit.
+class MultiScheduler {
+  // searches: [{ key, roller, target, algorithm, nonceStart }]
+  constructor({ workers, searches }) {
+    this.size = workers;
+    this.rates = new Array(workers).fill(0);
+    this.templates = new Map();
+    this.nextId = 0;
+    this.entries = searches.map(({ key, roller, target, algorithm = 'sha256d', nonceStart = 0 }) => ({
+      key,
+      target: Buffer.from(target),
+      algorithm,
+      expected: expectedHashes(target),
+      served: 0,
+      hashes: 0,
+      solved: false,
+      ids: new Map(),
+      scheduler: new NonceScheduler({ workers, roller, nonceStart, cost: pow.get(algorithm).cost.relative })
+    }));
+  }
+
+  // Global template for template t of entry e, registered on first use.
+  _global(e, t) {
+    let id = e.ids.get(t.index);
+    if (id === undefined) {
+      id = this.nextId++;
+      e.ids.set(t.index, id);
+      this.templates.set(id, { ...t, index: id, key: e.key, target: e.target, algorithm: e.algorithm });
+    }
+    return this.templates.get(id);
+  }
+
+  _pick() {
+    let best = null;
+    for (const e of this.entries) {
+      if (e.solved) continue;
+      if (!best || e.served / e.expected < best.served / best.expected) best = e;
+    }
+    return best;
+  }
+
+  next(i) {
+    const e = this._pick();
+    if (!e) return null;
+    const unit = e.scheduler.next(i);
+    e.served += unit.end - unit.start;
+    return { template: this._global(e, unit.template), start: unit.start, end: unit.end };
+  }
+
+  // Feeds a finished chunk's timing to its search's scheduler.
+  record(i, hashes, ms, id) {
+    const t = this.templates.get(id);
+    const e = t && this.entries.find(x => x.key === t.key);
+    if (e) {
+      e.hashes += hashes || 0;
+      e.scheduler.record(i, hashes, ms);
+    }
+    if (!hashes || !(ms > 0)) return;
+    const rate = hashes * 1000 / ms;
+    this.rates[i] = this.rates[i] ? this.rates[i] + RATE_ALPHA * (rate - this.rates[i]) : rate;
+  }
+
+  adopt() {}
+
+  // Marks a search solved; it gets no more chunks.
+  remove(key) {
+    const e = this.entries.find(x => x.key === key);
+    if (e) e.solved = true;
+  }
+
+  get remaining() {
+    return this.entries.filter(e => !e.solved).length;
+  }
+
+  prune(live) {
+    for (const e of this.entries) {
+      const local = [];
+      for (const [idx, id] of e.ids) if (live.includes(id)) local.push(idx);
+      e.scheduler.prune(local);
+      for (const [idx, id] of e.ids) {
+        if (e.solved ? !live.includes(id) : !e.scheduler.templates.has(idx)) {
+          e.ids.delete(idx);
+          this.templates.delete(id);
+        }
+      }
+    }
+  }
+
+  cursor() {
+    return this.entries.map(e => ({ key: e.key, ...e.scheduler.cursor() }));
+  }
+
+  // Per search: hashes reported so far and the share of its expected work.
+  progress() {
+    return this.entries.map(e => ({
+      key: e.key,
+      solved: e.solved,
+      hashes: e.hashes,
+      expected: Math.round(e.expected),
+      share: +(e.hashes / e.expected).toFixed(4)
+    }));
+  }
+
+  workerStats() {
+    return this.rates.map((rate, i) => ({
+      worker: i,
+      hashrate: Math.round(rate),
+      chunk: Math.max(...this.entries.map(e => e.scheduler.chunks[i])),
+      steals: this.entries.reduce((n, e) => n + e.scheduler.steals[i], 0)
+    }));
+  }
+}
+
+module.exports = { MultiScheduler, expectedHashes };
@@ -0,0 +1,26 @@
+// Loads the optional native hashing addon (native/, built with `npm run build:native`).
+// Everything falls back to the JS kernels when it is missing or SOULVAN_NO_NATIVE is set.
+const path = require('path');
+
+const CANDIDATES = [
+  path.join(__dirname, '..', 'native', 'build', 'Release', 'soulvan_hash.node'),
+  path.join(__dirname, '..', 'native', 'build', 'Debug', 'soulvan_hash.node')
+];
+
+function load() {
+  if (process.env.SOULVAN_NO_NATIVE) return null;
+  for (const p of CANDIDATES) {
+    try {
+      return require(p);
+    } catch {}
+  }
+  return null;
+}
+
+const addon = load();
+
+module.exports = {
+  addon,
+  available: !!addon,
+  impl: addon ? addon.cpuFeatures().impl : 'js'
+};
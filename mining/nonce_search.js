@@ -0,0 +1,126 @@
+const { IV, compress, bswap32, readBlock, writeDigest } = require('./sha256');
+const { targetWords, meetsTargetWords, hashToHex } = require('./target');
+const native = require('./native');
+
+const NONCE_OFFSET = 76;
+const NONCE_SPACE = 0x100000000;
+
+// SHA-256 state after the first 64 header bytes. These bytes do not change while
+// the nonce (or nTime) iterates, so one midstate serves a whole job.
+function computeMidstate(header) {
+  const state = new Uint32Array(IV);
+  compress(state, readBlock(header, 0, new Uint32Array(16)));
+  return state;
+}
+
+// Double-SHA-256 nonce search over one 80-byte block header.
+// All buffers are allocated up front; scan() only touches preallocated words,
+// hashing the 16-byte tail block from the midstate plus the second SHA-256.
+class NonceSearch {
+  constructor(header, target, midstate) {
+    if (!Buffer.isBuffer(header) || header.length !== 80) throw new Error('header must be an 80-byte Buffer');
+    if (!Buffer.isBuffer(target) || target.length !== 32) throw new Error('target must be a 32-byte Buffer');
+    this.header = Buffer.from(header);
+    this.target = Buffer.from(target);
+    this.targetWords = targetWords(this.target);
+    this.state = new Uint32Array(8);
+    this.digest = Buffer.alloc(32);
+
+    this.midstate = midstate ? Uint32Array.from(midstate) : computeMidstate(this.header);
+
+    // Padded tail block (header bytes 64..79); the nonce lives in block2[3].
+    this.block2 = new Uint32Array(16);
+    for (let i = 0; i < 4; i++) this.block2[i] = this.header.readUInt32BE(64 + i * 4);
+    this.block2[4] = 0x80000000;
+    this.block2[15] = 80 * 8;
+
+    // Second pass hashes the 32-byte first digest.
+    this.block3 = new Uint32Array(16);
+    this.block3[8] = 0x80000000;
+    this.block3[15] = 32 * 8;
+
+    this.setRange(this.header.readUInt32LE(NONCE_OFFSET), NONCE_SPACE);
+  }
+
+  // Restricts the search to nonces in [start, end).
+  setRange(start, end = NONCE_SPACE) {
+    this.nonce = start >>> 0;
+    this.end = Math.min(end, NONCE_SPACE);
+  }
+
+  get exhausted() {
+    return this.nonce >= this.end;
+  }
+
+  // Hashes the header with `nonce`; the final SHA-256 state is left in this.state.
+  hashState(nonce) {
+    const s = this.state;
+    this.block2[3] = bswap32(nonce);
+
+    s.set(this.midstate);
+    compress(s, this.block2);
+
+    const b3 = this.block3;
+    for (let i = 0; i < 8; i++) b3[i] = s[i];
+    s.set(IV);
+    compress(s, b3);
+    return s;
+  }
+
+  // Hashes the header with `nonce` and leaves the raw digest in this.digest.
+  hashNonce(nonce) {
+    return writeDigest(this.hashState(nonce), this.digest);
+  }
+
+  // Tries up to `count` nonces. Stops early on the first hash that meets the target.
+  // The most significant digest word settles almost every nonce; only hashes that
+  // tie or beat the target's top word get the full 256-bit compare.
+  scan(count) {
+    const stop = Math.min(this.nonce + count, this.end);
+    const first = this.nonce;
+    const words = this.targetWords;
+    const top = words[0];
+    for (let n = first; n < stop; n++) {
+      const s = this.hashState(n);
+      if (bswap32(s[7]) > top || !meetsTargetWords(s, words)) continue;
+      this.nonce = n + 1;
+      this.header.writeUInt32LE(n, NONCE_OFFSET);
+      writeDigest(s, this.digest);
+      return { hashes: n + 1 - first, found: true, nonce: n, hash: hashToHex(this.digest) };
+    }
+    this.nonce = stop;
+    return { hashes: stop - first, found: false };
+  }
+}
+
+// Same interface, but each scan() runs the whole nonce range inside the native
+// addon and only the winning nonce crosses back into JS.
+class NativeNonceSearch extends NonceSearch {
+  constructor(header, target, midstate) {
+    super(header, target, midstate);
+    this.midstateBytes = writeDigest(this.midstate, Buffer.alloc(32));
+    this.tail = this.header.subarray(64, 80);
+  }
+
+  scan(count) {
+    const first = this.nonce;
+    const span = Math.min(count, this.end - first);
+    const winners = native.addon.scanRange(this.midstateBytes, this.tail, this.target, first, span, 1);
+    if (winners.length) {
+      const n = winners[0];
+      this.nonce = n + 1;
+      this.header.writeUInt32LE(n, NONCE_OFFSET);
+      this.hashNonce(n);
+      return { hashes: n + 1 - first, found: true, nonce: n, hash: hashToHex(this.digest) };
+    }
+    this.nonce = first + span;
+    return { hashes: span, found: false };
+  }
+}
+
+// Picks the native kernel when the addon is built, the JS one otherwise.
+function createSearch(header, target, midstate) {
+  return native.available ? new NativeNonceSearch(header, target, midstate) : new NonceSearch(header, target, midstate);
+}
+
+module.exports = { NonceSearch, NativeNonceSearch, createSearch, computeMidstate, NONCE_OFFSET, NONCE_SPACE };
@@ -0,0 +1,595 @@
+// Pool mining. configure()/getConfig() hold the pool settings the external
+// miners are launched with; start() runs the built-in engine against a
+// Stratum v1 or v2 pool directly, so job intake and hashing share one process.
+const net = require('net');
+const { EventEmitter } = require('events');
+const { performance } = require('perf_hooks');
+const minerCore = require('./miner_core');
+const { FrameDecoder, encode, targetFromWire, PROTOCOL_MINING, REQUIRES_STANDARD_JOBS, VERSION } = require('./stratum_v2');
+
+let poolConfig = { poolUrl: '', user: '', password: 'x' };
+
+// Difficulty 1 share target (bdiff): 0xffff << 208.
+const DIFF1 = 0xffffn << 208n;
+const MAX_TARGET = (1n << 256n) - 1n;
+// How long start() waits for the pool's first job.
+const JOB_TIMEOUT_MS = 30000;
+// How long a request (v1) or share (v2) waits for the pool's answer.
+const REQUEST_TIMEOUT_MS = 30000;
+
+// 'stratum+tcp://host:port' (stratum2+tcp for v2, or plain 'host:port')
+// -> { host, port }.
+function parseUrl(url) {
+  const m = /^(?:[a-z0-9+]+:\/\/)?\[?([^\]/]+?)\]?:(\d+)\/?$/i.exec(String(url).trim());
+  if (!m) throw new Error(`Bad pool URL: ${url}`);
+  return { host: m[1], port: Number(m[2]) };
+}
+
+// 32-byte big-endian share target for a pool difficulty (may be below 1).
+function difficultyToTarget(diff) {
+  const scaled = BigInt(Math.max(1, Math.round(diff * 2 ** 32)));
+  let t = (DIFF1 << 32n) / scaled;
+  if (t > MAX_TARGET) t = MAX_TARGET;
+  return Buffer.from(t.toString(16).padStart(64, '0'), 'hex');
+}
+
+// Stratum numbers (version, nbits, ntime, nonce) are big-endian hex.
+function hex32(n) {
+  return (n >>> 0).toString(16).padStart(8, '0');
+}
+
+// extranonce2 for a rolled extranonce: little-endian, exactly `size` bytes.
+function extranonce2(n, size) {
+  const out = Buffer.alloc(size);
+  for (let i = 0; i < Math.min(size, 4); i++) out[i] = (n >>> (8 * i)) & 0xff;
+  return out;
+}
+
+// mining.notify params -> a miner_core job (see newJob). The prevhash comes
+// as eight 4-byte words, each byte-swapped against header order; branch
+// hashes are already in internal order.
+function jobFromNotify(params, { extranonce1, extranonce2Size, difficulty }) {
+  const [jobId, prevHash, coinb1, coinb2, branch, version, bits, time, clean] = params;
+  const head = Buffer.concat([Buffer.from(coinb1, 'hex'), Buffer.from(extranonce1, 'hex')]);
+  const tail = Buffer.from(coinb2, 'hex');
+  return {
+    jobId,
+    clean: !!clean,
+    difficulty,
+    prevHash: Buffer.from(prevHash, 'hex').swap32(),
+    version: parseInt(version, 16),
+    bits: parseInt(bits, 16),
+    time: parseInt(time, 16),
+    target: difficultyToTarget(difficulty),
+    merkleBranch: branch.map(h => Buffer.from(h, 'hex')),
+    coinbaseFor: (n) => Buffer.concat([head, extranonce2(n, extranonce2Size), tail]),
+    // Only extranonce2 is rolled; not every pool accepts a moved ntime.
+    timeWindow: 0
+  };
+}
+
+function stratumError(err) {
+  if (!err) return 'rejected';
+  return Array.isArray(err) ? `${err[1]} (${err[0]})` : String(err.message || err);
+}
+
+// Stratum v1 client: newline-delimited JSON-RPC over TCP. Emits 'job' for
+// every mining.notify (parsed with jobFromNotify; 'notify' has the raw
+// params, for relaying), 'difficulty', 'extranonce' and 'close'.
+// Submits are pipelined: each goes out as soon as it is found, without
+// waiting on earlier answers, and its round trip is timed. A request the
+// pool leaves unanswered for requestTimeoutMs is rejected.
+class StratumClient extends EventEmitter {
+  constructor({ url, user, password = 'x', agent = 'soulvan-miner/0.3', requestTimeoutMs = REQUEST_TIMEOUT_MS }) {
+    super();
+    this.url = url;
+    this.user = user;
+    this.password = password;
+    this.agent = agent;
+    this.requestTimeoutMs = requestTimeoutMs;
+    this.nextId = 1;
+    this.pending = new Map();
+    this.buffer = '';
+    this.extranonce1 = '';
+    this.extranonce2Size = 4;
+    this.difficulty = 1;
+    this.job = null;
+    this.connected = false;
+    this.shares = { submitted: 0, accepted: 0, rejected: 0, lastMs: 0, totalMs: 0, maxMs: 0, lastError: null };
+  }
+
+  // Connects, subscribes and authorizes. Until then failures only reject
+  // the returned promise; 'error' is emitted once connected.
+  connect() {
+    const { host, port } = parseUrl(this.url);
+    return new Promise((resolve, reject) => {
+      const socket = this.socket = net.connect({ host, port });
+      socket.setNoDelay(true);
+      socket.setEncoding('utf8');
+      socket.on('data', (chunk) => this._onData(chunk));
+      socket.on('error', (err) => {
+        if (this.connected) this.emit('error', err);
+        else reject(err);
+      });
+      socket.on('close', () => {
+        for (const p of this.pending.values()) {
+          clearTimeout(p.timer);
+          p.reject(new Error('Pool connection closed'));
+        }
+        this.pending.clear();
+        this.emit('close');
+      });
+      socket.on('connect', () => {
+        this.request('mining.subscribe', [this.agent])
+          .then(([, extranonce1, size]) => {
+            this.extranonce1 = extranonce1;
+            this.extranonce2Size = size;
+            return this.request('mining.authorize', [this.user, this.password]);
+          })
+          .then((ok) => {
+            if (!ok) throw new Error('Pool authorization failed');
+            this.connected = true;
+            resolve();
+          })
+          .catch(reject);
+      });
+    });
+  }
+
+  request(method, params) {
+    const id = this.nextId++;
+    this.socket.write(`${JSON.stringify({ id, method, params })}\n`);
+    return new Promise((resolve, reject) => {
+      const timer = setTimeout(() => {
+        this.pending.delete(id);
+        reject(new Error(`${method} timed out`));
+      }, this.requestTimeoutMs);
+      this.pending.set(id, { resolve, reject, timer });
+    });
+  }
+
+  _onData(chunk) {
+    this.buffer += chunk;
+    let nl;
+    while ((nl = this.buffer.indexOf('\n')) >= 0) {
+      const line = this.buffer.slice(0, nl).trim();
+      this.buffer = this.buffer.slice(nl + 1);
+      if (!line) continue;
+      let msg;
+      try {
+        msg = JSON.parse(line);
+      } catch (e) {
+        if (this.connected) this.emit('error', new Error(`Bad pool message: ${line.slice(0, 80)}`));
+        continue;
+      }
+      this._onMessage(msg);
+    }
+  }
+
+  _onMessage(msg) {
+    if (msg.id !== null && msg.id !== undefined && this.pending.has(msg.id)) {
+      const p = this.pending.get(msg.id);
+      this.pending.delete(msg.id);
+      clearTimeout(p.timer);
+      if (msg.error) p.reject(new Error(stratumError(msg.error)));
+      else p.resolve(msg.result);
+      return;
+    }
+    if (msg.method === 'mining.set_difficulty') {
+      // Applies from the next job on.
+      this.difficulty = Number(msg.params[0]);
+      this.emit('difficulty', this.difficulty);
+    } else if (msg.method === 'mining.set_extranonce') {
+      // Applies from the next job on.
+      [this.extranonce1, this.extranonce2Size] = msg.params;
+      this.emit('extranonce', this.extranonce1, this.extranonce2Size);
+    } else if (msg.method === 'mining.notify') {
+      this.job = jobFromNotify(msg.params, this);
+      this.emit('notify', msg.params);
+      this.emit('job', this.job);
+    }
+  }
+
+  // share: { jobId, extranonce, time, nonce }. Resolves with
+  // { accepted, latencyMs, error }; never rejects.
+  submit({ jobId, extranonce, time, nonce }) {
+    const sent = performance.now();
+    this.shares.submitted++;
+    const en2 = extranonce2(extranonce, this.extranonce2Size).toString('hex');
+    return this.request('mining.submit', [this.user, jobId, en2, hex32(time), hex32(nonce)])
+      .then(result => ({ accepted: result === true, error: result === true ? null : 'rejected' }),
+        err => ({ accepted: false, error: err.message }))
+      .then((res) => {
+        const latencyMs = performance.now() - sent;
+        const s = this.shares;
+        if (res.accepted) s.accepted++;
+        else {
+          s.rejected++;
+          s.lastError = res.error;
+        }
+        s.lastMs = latencyMs;
+        s.totalMs += latencyMs;
+        s.maxMs = Math.max(s.maxMs, latencyMs);
+        return { ...res, latencyMs };
+      });
+  }
+
+  // Share counts and submit round trips (ms), for the stats line.
+  stats() {
+    const s = this.shares;
+    const answered = s.accepted + s.rejected;
+    return {
+      url: this.url,
+      difficulty: this.difficulty,
+      jobId: this.job ? this.job.jobId : null,
+      submitted: s.submitted,
+      accepted: s.accepted,
+      rejected: s.rejected,
+      inFlight: s.submitted - answered,
+      lastError: s.lastError,
+      latencyMs: {
+        last: +s.lastMs.toFixed(2),
+        avg: answered ? +(s.totalMs / answered).toFixed(2) : 0,
+        max: +s.maxMs.toFixed(2)
+      }
+    };
+  }
+
+  close() {
+    if (this.socket) this.socket.destroy();
+  }
+}
+
+// Stratum v2 counterpart of StratumClient (framing in stratum_v2.js), with
+// the same events ('job', 'close', 'error') and submit()/stats()/close(), so
+// start() drives either. channel 'standard' is header-only mining: the
+// pool sends merkle roots and only nonce and nTime are rolled. 'extended'
+// gets the coinbase and merkle path and rolls its extranonce part.
+//
+// Jobs arrive as future jobs and become active with SetNewPrevHash, or at
+// once when they carry min_ntime. Submits are pipelined by sequence number;
+// the pool may acknowledge many with one SubmitShares.Success.
+class Sv2Client extends EventEmitter {
+  constructor({ url, user, channel = 'standard', hashrate = 1e6, agent = 'soulvan-miner/0.3', requestTimeoutMs = REQUEST_TIMEOUT_MS }) {
+    super();
+    this.url = url;
+    this.user = user;
+    this.channel = channel;
+    this.hashrate = hashrate;
+    this.agent = agent;
+    this.requestTimeoutMs = requestTimeoutMs;
+    this.decoder = new FrameDecoder();
+    this.channelId = null;
+    this.target = null;
+    this.extranoncePrefix = Buffer.alloc(0);
+    this.extranonceSize = 0;
+    this.jobs = new Map();
+    this.prev = null;
+    this.job = null;
+    this.sequence = 0;
+    this.pending = new Map();
+    this.waiting = null;
+    this.connected = false;
+    this.bytes = { sent: 0, received: 0 };
+    this.shares = { submitted: 0, accepted: 0, rejected: 0, lastMs: 0, totalMs: 0, maxMs: 0, lastError: null };
+  }
+
+  // Connects, sets up the connection and opens one mining channel. Like
+  // StratumClient, 'error' is only emitted once connected.
+  connect() {
+    const { host, port } = parseUrl(this.url);
+    return new Promise((resolve, reject) => {
+      const socket = this.socket = net.connect({ host, port });
+      socket.setNoDelay(true);
+      socket.on('data', (chunk) => {
+        this.bytes.received += chunk.length;
+        let messages;
+        try {
+          messages = this.decoder.push(chunk);
+        } catch (e) {
+          // The stream can't be resynchronised after a bad frame.
+          if (this.connected) this.emit('error', new Error(`Bad pool message: ${e.message}`));
+          socket.destroy();
+          return;
+        }
+        for (const { name, msg } of messages) this._onMessage(name, msg);
+      });
+      socket.on('error', (err) => {
+        if (this.connected) this.emit('error', err);
+        else reject(err);
+      });
+      socket.on('close', () => {
+        if (this.waiting) this.waiting.reject(new Error('Pool connection closed'));
+        this.waiting = null;
+        for (const p of this.pending.values()) {
+          clearTimeout(p.timer);
+          p.resolve({ accepted: false, error: 'Pool connection closed' });
+        }
+        this.pending.clear();
+        this.emit('close');
+      });
+      socket.on('connect', () => {
+        this._expect('SetupConnectionSuccess', 'SetupConnectionError')
+          .then(() => {
+            const open = this.channel === 'extended' ? 'OpenExtendedMiningChannel' : 'OpenStandardMiningChannel';
+            const done = this._expect(`${open}Success`, 'OpenMiningChannelError');
+            this.send(open, {
+              requestId: 1,
+              userIdentity: this.user,
+              nominalHashRate: this.hashrate,
+              maxTarget: Buffer.alloc(32, 0xff),
+              minExtranonceSize: 4
+            });
+            return done;
+          })
+          .then(() => {
+            this.connected = true;
+            resolve();
+          }, reject);
+        this.send('SetupConnection', {
+          protocol: PROTOCOL_MINING,
+          minVersion: VERSION,
+          maxVersion: VERSION,
+          flags: this.channel === 'extended' ? 0 : REQUIRES_STANDARD_JOBS,
+          endpointHost: host,
+          endpointPort: port,
+          vendor: this.agent,
+          hardwareVersion: 'cpu',
+          firmware: '',
+          deviceId: ''
+        });
+      });
+    });
+  }
+
+  send(name, msg) {
+    const frame = encode(name, msg);
+    this.bytes.sent += frame.length;
+    this.socket.write(frame);
+  }
+
+  // Resolves with the next `ok` message, rejects on the next `error` one.
+  _expect(ok, error) {
+    return new Promise((resolve, reject) => {
+      this.waiting = { ok, error, resolve, reject };
+    });
+  }
+
+  _onMessage(name, msg) {
+    if (name === 'OpenStandardMiningChannelSuccess' || name === 'OpenExtendedMiningChannelSuccess') {
+      // Set here, not when the promise settles: the first job may be in the
+      // same chunk.
+      this.channelId = msg.channelId;
+      this.target = targetFromWire(msg.target);
+      this.extranoncePrefix = msg.extranoncePrefix;
+      this.extranonceSize = msg.extranonceSize || 0;
+    }
+    const w = this.waiting;
+    if (w && (name === w.ok || name === w.error)) {
+      this.waiting = null;
+      if (name === w.ok) w.resolve(msg);
+      else w.reject(new Error(`Pool refused: ${msg.errorCode}`));
+      return;
+    }
+    if (name === 'NewMiningJob' || name === 'NewExtendedMiningJob') {
+      this.jobs.set(msg.jobId, { name, ...msg });
+      // Same block: shares of the jobs before it stay valid.
+      if (msg.minNtime !== null && this.prev) this._activate(msg.jobId, msg.minNtime, false);
+    } else if (name === 'SetNewPrevHash') {
+      this.prev = msg;
+      // Jobs for the old block are void now.
+      for (const id of this.jobs.keys()) if (id !== msg.jobId) this.jobs.delete(id);
+      this._activate(msg.jobId, msg.minNtime, true);
+    } else if (name === 'SetTarget') {
+      // Applies from the next job on.
+      this.target = targetFromWire(msg.maximumTarget);
+    } else if (name === 'SubmitSharesSuccess') {
+      for (const [seq, p] of this.pending) {
+        if (seq > msg.lastSequenceNumber) break;
+        this.pending.delete(seq);
+        clearTimeout(p.timer);
+        p.resolve({ accepted: true, error: null });
+      }
+    } else if (name === 'SubmitSharesError') {
+      const p = this.pending.get(msg.sequenceNumber);
+      if (p) {
+        this.pending.delete(msg.sequenceNumber);
+        clearTimeout(p.timer);
+        p.resolve({ accepted: false, error: msg.errorCode });
+      }
+    }
+  }
+
+  // Turns a channel job into a miner_core job and emits it.
+  _activate(jobId, minNtime, clean) {
+    const j = this.jobs.get(jobId);
+    if (!j || !this.prev) return;
+    const job = {
+      jobId,
+      clean,
+      prevHash: this.prev.prevHash,
+      version: j.version,
+      bits: this.prev.nbits,
+      time: Math.max(minNtime, this.prev.minNtime),
+      target: this.target
+    };
+    if (j.name === 'NewMiningJob') {
+      job.merkleRoot = j.merkleRoot;
+    } else {
+      const head = Buffer.concat([j.coinbaseTxPrefix, this.extranoncePrefix]);
+      job.merkleBranch = j.merklePath;
+      job.coinbaseFor = (n) => Buffer.concat([head, this.extranonceFor(n), j.coinbaseTxSuffix]);
+      job.timeWindow = 0;
+    }
+    this.job = job;
+    this.emit('job', job);
+  }
+
+  // The miner's part of the extranonce for a rolled extranonce.
+  extranonceFor(n) {
+    return extranonce2(n, this.extranonceSize);
+  }
+
+  // share: { jobId, extranonce, time, nonce, version }. Resolves with
+  // { accepted, latencyMs, error }; never rejects.
+  submit({ jobId, extranonce, time, nonce, version }) {
+    const sent = performance.now();
+    const sequenceNumber = this.sequence++;
+    this.shares.submitted++;
+    const answer = new Promise((resolve) => {
+      const timer = setTimeout(() => {
+        this.pending.delete(sequenceNumber);
+        resolve({ accepted: false, error: 'Share timed out' });
+      }, this.requestTimeoutMs);
+      this.pending.set(sequenceNumber, { resolve, timer });
+    });
+    const share = { channelId: this.channelId, sequenceNumber, jobId, nonce, ntime: time, version };
+    if (this.channel === 'extended') this.send('SubmitSharesExtended', { ...share, extranonce: this.extranonceFor(extranonce) });
+    else this.send('SubmitSharesStandard', share);
+    return answer.then((res) => {
+      const latencyMs = performance.now() - sent;
+      const s = this.shares;
+      if (res.accepted) s.accepted++;
+      else {
+        s.rejected++;
+        s.lastError = res.error;
+      }
+      s.lastMs = latencyMs;
+      s.totalMs += latencyMs;
+      s.maxMs = Math.max(s.maxMs, latencyMs);
+      return { ...res, latencyMs };
+    });
+  }
+
+  // Same shape as StratumClient#stats, plus the channel and wire bytes.
+  stats() {
+    const s = this.shares;
+    const answered = s.accepted + s.rejected;
+    return {
+      url: this.url,
+      protocol: 2,
+      channel: this.channel,
+      jobId: this.job ? this.job.jobId : null,
+      submitted: s.submitted,
+      accepted: s.accepted,
+      rejected: s.rejected,
+      inFlight: s.submitted - answered,
+      lastError: s.lastError,
+      bytes: { ...this.bytes },
+      latencyMs: {
+        last: +s.lastMs.toFixed(2),
+        avg: answered ? +(s.totalMs / answered).toFixed(2) : 0,
+        max: +s.maxMs.toFixed(2)
+      }
+    };
+  }
+
+  close() {
+    if (this.socket) this.socket.destroy();
+  }
+}
+
+// Stratum clients of running built-in pool miners, by miner id.
+const sessions = new Map();
+
+// Client for a pool URL: stratum2+tcp:// speaks Stratum v2, anything else v1.
+function createClient({ url, user, password, channel }) {
+  return /^stratum2\+tcp:/i.test(url)
+    ? new Sv2Client({ url, user, channel })
+    : new StratumClient({ url, user, password });
+}
+
+// Mines on the built-in worker pool for a Stratum pool: every job goes
+// straight into miner_core.newJob and every share straight back as a submit.
+// options are miner_core's plus poolUrl, address (the pool user), password
+// and, for v2, channel ('standard' or 'extended'); they default to
+// configure()'s. Resolves with the miner id once the first job is in.
+async function start(options, onStats, onEvent) {
+  const client = createClient({
+    url: options.poolUrl || poolConfig.poolUrl,
+    user: options.address || poolConfig.user,
+    password: options.password || poolConfig.password,
+    channel: options.channel
+  });
+  client.on('error', () => {});
+  // Listening from the start: the first job may come in with the connect
+  // answers.
+  let timer;
+  let onJob;
+  const firstJob = new Promise((resolve, reject) => {
+    timer = setTimeout(() => reject(new Error('No job from pool')), JOB_TIMEOUT_MS);
+    onJob = (job) => {
+      clearTimeout(timer);
+      resolve(job);
+    };
+    client.once('job', onJob);
+  });
+  // Not awaited when connect() fails first.
+  firstJob.catch(() => {});
+  try {
+    await client.connect();
+    await firstJob;
+  } catch (e) {
+    clearTimeout(timer);
+    client.removeListener('job', onJob);
+    client.close();
+    throw e;
+  }
+
+  // Stale shares never get here (miner_core drops them); f.tag is the job
+  // the share was mined on, which after a non-clean notify may be an
+  // earlier one the pool still accepts.
+  const submit = (f) => client.submit({
+    jobId: f.tag.jobId,
+    extranonce: f.template.extranonce,
+    time: f.header.readUInt32LE(68),
+    nonce: f.header.readUInt32LE(76),
+    version: f.header.readUInt32LE(0)
+  }).then(res => res.accepted);
+
+  let id;
+  try {
+    id = minerCore.start({ ...options, job: client.job, submit },
+      (stats) => onStats && onStats({ ...stats, pool: client.stats() }), onEvent);
+  } catch (e) {
+    // Bad miner options (unknown coin, seed with idle): drop the session.
+    client.close();
+    throw e;
+  }
+  sessions.set(id, client);
+  client.on('job', next => minerCore.newJob(id, next));
+  client.on('close', () => {
+    if (!sessions.has(id)) return;
+    stop(id);
+    onEvent && onEvent({ type: 'error', id, error: 'Pool connection closed' });
+  });
+  return id;
+}
+
+// Stops a miner started by start(); false when the id is not one of ours.
+function stop(id) {
+  const client = sessions.get(id);
+  if (!client) return false;
+  sessions.delete(id);
+  minerCore.stop(id);
+  client.close();
+  return true;
+}
+
+module.exports = {
+  configure: (cfg) => {
+    poolConfig = { ...poolConfig, ...cfg };
+    return { ok: true, poolConfig };
+  },
+  getConfig: () => poolConfig,
+  start,
+  stop,
+  StratumClient,
+  Sv2Client,
+  createClient,
+  jobFromNotify,
+  difficultyToTarget,
+  extranonce2,
+  parseUrl,
+  hex32
+};
@@ -0,0 +1,17 @@
+// BLAKE2b over the header. node only exposes the 512-bit variant, so the PoW
+// hash is its first 32 bytes (not the same as a native BLAKE2b-256).
+const crypto = require('crypto');
+const { HeaderSearch } = require('./header_search');
+
+function hash(header) {
+  return crypto.createHash('blake2b512').update(header).digest().subarray(0, 32);
+}
+
+module.exports = {
+  name: 'blake2b',
+  description: 'BLAKE2b-512 of the header, truncated to 256 bits',
+  impl: 'openssl',
+  cost: { relative: 2, memoryBytes: 0 },
+  hash,
+  createSearch: (header, target) => new HeaderSearch(header, target, hash)
+};
@@ -0,0 +1,41 @@
+const { NONCE_OFFSET, NONCE_SPACE } = require('../nonce_search');
+const { meetsTarget, hashToHex } = require('../target');
+
+// Nonce-range search for PoW functions without a midstate shortcut: the whole
+// 80-byte header is hashed per nonce. Same interface as NonceSearch
+// (setRange / exhausted / scan), so the worker and scheduler code is shared.
+class HeaderSearch {
+  constructor(header, target, hash) {
+    this.header = Buffer.from(header);
+    this.target = Buffer.from(target);
+    this.targetTop = this.target.readUInt32BE(0);
+    this.hash = hash;
+    this.setRange(this.header.readUInt32LE(NONCE_OFFSET));
+  }
+
+  setRange(start, end = NONCE_SPACE) {
+    this.nonce = start >>> 0;
+    this.end = Math.min(end, NONCE_SPACE);
+  }
+
+  get exhausted() {
+    return this.nonce >= this.end;
+  }
+
+  // Tries up to `count` nonces; rejects on the top digest word before the full compare.
+  scan(count) {
+    const stop = Math.min(this.nonce + count, this.end);
+    const first = this.nonce;
+    for (let n = first; n < stop; n++) {
+      this.header.writeUInt32LE(n, NONCE_OFFSET);
+      const digest = this.hash(this.header);
+      if (digest.readUInt32LE(28) > this.targetTop || !meetsTarget(digest, this.target)) continue;
+      this.nonce = n + 1;
+      return { hashes: n + 1 - first, found: true, nonce: n, hash: hashToHex(digest) };
+    }
+    this.nonce = stop;
+    return { hashes: stop - first, found: false };
+  }
+}
+
+module.exports = { HeaderSearch };
@@ -0,0 +1,34 @@
+// Proof-of-work algorithm registry. Every algorithm module exports:
+//
+//   name          registry key, referenced by config/coins.json
+//   description   one line for the UI and benchmark output
+//   impl          what backs it here: 'sha-ni' / 'avx2' / 'scalar' (native addon), 'openssl' or 'js'
+//   cost          { relative, memoryBytes }: per-hash cost against JS sha256d and
+//                 scratch memory per hash; batch and chunk sizes are divided by
+//                 `relative` so slow functions keep the same time per slice
+//   hash(header)  raw 32-byte PoW digest of an 80-byte header
+//   createSearch(header, target, midstate)
+//                 nonce-range search with setRange / exhausted / scan, used both
+//                 in-process and inside the worker threads
+const ALGORITHMS = new Map();
+
+function register(algo) {
+  ALGORITHMS.set(algo.name, algo);
+}
+
+register(require('./sha256d'));
+register(require('./scrypt'));
+register(require('./blake2b'));
+register(require('./keccak'));
+
+function get(name = 'sha256d') {
+  const algo = ALGORITHMS.get(name);
+  if (!algo) throw new Error(`Unknown PoW algorithm: ${name}`);
+  return algo;
+}
+
+function list() {
+  return [...ALGORITHMS.values()].map(({ name, description, impl, cost }) => ({ name, description, impl, cost }));
+}
+
+module.exports = { register, get, list };
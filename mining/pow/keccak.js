@@ -0,0 +1,110 @@
+// Keccak-256 (original Keccak padding, as used by Ethereum; not NIST SHA3-256).
+// node's crypto only ships SHA3, so this is a plain JS keccak-f[1600] with each
+// 64-bit lane kept as two 32-bit halves (lo at 2i, hi at 2i + 1).
+const { HeaderSearch } = require('./header_search');
+
+const RATE = 136;
+
+const RC = new Uint32Array([
+  0x00000001, 0x00000000, 0x00008082, 0x00000000, 0x0000808a, 0x80000000, 0x80008000, 0x80000000,
+  0x0000808b, 0x00000000, 0x80000001, 0x00000000, 0x80008081, 0x80000000, 0x00008009, 0x80000000,
+  0x0000008a, 0x00000000, 0x00000088, 0x00000000, 0x80008009, 0x00000000, 0x8000000a, 0x00000000,
+  0x8000808b, 0x00000000, 0x0000008b, 0x80000000, 0x00008089, 0x80000000, 0x00008003, 0x80000000,
+  0x00008002, 0x80000000, 0x00000080, 0x80000000, 0x0000800a, 0x00000000, 0x8000000a, 0x80000000,
+  0x80008081, 0x80000000, 0x00008080, 0x80000000, 0x80000001, 0x00000000, 0x80008008, 0x80000000
+]);
+
+// Rotation offset of lane x + 5y.
+const ROT = [0, 1, 62, 28, 27, 36, 44, 6, 55, 20, 3, 10, 43, 25, 39, 41, 45, 15, 21, 8, 18, 2, 61, 56, 14];
+
+// Destination lane of x + 5y after pi: (y, 2x + 3y).
+const PI = ROT.map((_, i) => {
+  const x = i % 5;
+  const y = (i / 5) | 0;
+  return y + 5 * ((2 * x + 3 * y) % 5);
+});
+
+const A = new Uint32Array(50);
+const B = new Uint32Array(50);
+const C = new Uint32Array(10);
+
+function keccakF() {
+  for (let round = 0; round < 24; round++) {
+    // theta
+    for (let x = 0; x < 5; x++) {
+      C[2 * x] = A[2 * x] ^ A[2 * x + 10] ^ A[2 * x + 20] ^ A[2 * x + 30] ^ A[2 * x + 40];
+      C[2 * x + 1] = A[2 * x + 1] ^ A[2 * x + 11] ^ A[2 * x + 21] ^ A[2 * x + 31] ^ A[2 * x + 41];
+    }
+    for (let x = 0; x < 5; x++) {
+      const l = C[2 * ((x + 1) % 5)];
+      const h = C[2 * ((x + 1) % 5) + 1];
+      const dl = C[2 * ((x + 4) % 5)] ^ ((l << 1) | (h >>> 31));
+      const dh = C[2 * ((x + 4) % 5) + 1] ^ ((h << 1) | (l >>> 31));
+      for (let y = 0; y < 25; y += 5) {
+        A[2 * (x + y)] ^= dl;
+        A[2 * (x + y) + 1] ^= dh;
+      }
+    }
+    // rho + pi
+    for (let i = 0; i < 25; i++) {
+      const l = A[2 * i];
+      const h = A[2 * i + 1];
+      const r = ROT[i];
+      const j = 2 * PI[i];
+      if (r === 0) {
+        B[j] = l; B[j + 1] = h;
+      } else if (r < 32) {
+        B[j] = (l << r) | (h >>> (32 - r));
+        B[j + 1] = (h << r) | (l >>> (32 - r));
+      } else if (r === 32) {
+        B[j] = h; B[j + 1] = l;
+      } else {
+        const m = r - 32;
+        B[j] = (h << m) | (l >>> (32 - m));
+        B[j + 1] = (l << m) | (h >>> (32 - m));
+      }
+    }
+    // chi
+    for (let y = 0; y < 25; y += 5) {
+      for (let x = 0; x < 5; x++) {
+        const i = 2 * (x + y);
+        const i1 = 2 * ((x + 1) % 5 + y);
+        const i2 = 2 * ((x + 2) % 5 + y);
+        A[i] = B[i] ^ (~B[i1] & B[i2]);
+        A[i + 1] = B[i + 1] ^ (~B[i1 + 1] & B[i2 + 1]);
+      }
+    }
+    // iota
+    A[0] ^= RC[2 * round];
+    A[1] ^= RC[2 * round + 1];
+  }
+}
+
+function absorb(block, offset) {
+  for (let i = 0; i < RATE / 4; i++) A[i] ^= block.readUInt32LE(offset + i * 4);
+  keccakF();
+}
+
+function keccak256(data) {
+  A.fill(0);
+  let off = 0;
+  for (; off + RATE <= data.length; off += RATE) absorb(data, off);
+  const last = Buffer.alloc(RATE);
+  data.copy(last, 0, off);
+  last[data.length - off] ^= 0x01;
+  last[RATE - 1] ^= 0x80;
+  absorb(last, 0);
+  const out = Buffer.alloc(32);
+  for (let i = 0; i < 8; i++) out.writeUInt32LE(A[i] >>> 0, i * 4);
+  return out;
+}
+
+module.exports = {
+  name: 'keccak',
+  description: 'Keccak-256 of the 80-byte header',
+  impl: 'js',
+  cost: { relative: 12, memoryBytes: 0 },
+  hash: keccak256,
+  createSearch: (header, target) => new HeaderSearch(header, target, keccak256),
+  keccak256
+};
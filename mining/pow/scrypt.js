@@ -0,0 +1,19 @@
+// Litecoin-style scrypt: N=1024, r=1, p=1 with the header as password and salt.
+// Runs in node's OpenSSL scrypt; each hash touches 128 KiB of scratch memory.
+const crypto = require('crypto');
+const { HeaderSearch } = require('./header_search');
+
+const PARAMS = { N: 1024, r: 1, p: 1 };
+
+function hash(header) {
+  return crypto.scryptSync(header, header, 32, PARAMS);
+}
+
+module.exports = {
+  name: 'scrypt',
+  description: 'scrypt(N=1024, r=1, p=1) of the header',
+  impl: 'openssl',
+  cost: { relative: 400, memoryBytes: 128 * PARAMS.r * PARAMS.N },
+  hash,
+  createSearch: (header, target) => new HeaderSearch(header, target, hash)
+};
@@ -0,0 +1,14 @@
+// Bitcoin's double SHA-256. The only algorithm with a midstate shortcut and
+// the native SHA-NI / AVX2 nonce kernels.
+const { sha256d } = require('../sha256');
+const { createSearch } = require('../nonce_search');
+const native = require('../native');
+
+module.exports = {
+  name: 'sha256d',
+  description: 'SHA-256(SHA-256(header))',
+  impl: native.impl,
+  cost: { relative: 1, memoryBytes: 0 },
+  hash: sha256d,
+  createSearch
+};
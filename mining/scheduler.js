@@ -0,0 +1,160 @@
+const { NONCE_SPACE } = require('./nonce_search');
+const { freeRanges } = require('./checkpoint');
+
+const TARGET_CHUNK_MS = 75;
+const MIN_CHUNK = 1 << 12;
+const MAX_CHUNK = 1 << 28;
+const INITIAL_CHUNK = 1 << 16;
+const RATE_ALPHA = 0.3;
+
+// Hands out nonce chunks from per-worker deques with work stealing.
+//
+// Each template's nonce space is seeded as one range per worker deque. A worker
+// takes chunks off the front of its own deque; when that is empty it steals the
+// back half of the fullest deque, and only when every deque is empty is the
+// next template rolled. Chunk size follows each worker's measured hashrate so
+// that one chunk takes ~TARGET_CHUNK_MS, which keeps fast and slow (or
+// throttled) cores finishing together.
+//
+// `cost` is the PoW algorithm's relative per-hash cost (mining/pow); the
+// initial and minimum chunk sizes shrink with it so slow functions still
+// hand out chunks of about the same duration.
+//
+// `resume` ({ rolled, doneBelow, completed: Map(template -> ranges) }, from a
+// SearchCheckpoint) replays the roller up to the saved template and seeds only
+// the ranges that were not finished; templates below doneBelow are skipped.
+class NonceScheduler {
+  constructor({ workers, roller, nonceStart = 0, targetChunkMs = TARGET_CHUNK_MS, cost = 1, resume = null }) {
+    this.size = workers;
+    this.roller = roller;
+    this.targetChunkMs = targetChunkMs;
+    this.minChunk = Math.max(1, Math.round(MIN_CHUNK / cost));
+    this.deques = Array.from({ length: workers }, () => []);
+    this.rates = new Array(workers).fill(0);
+    this.chunks = new Array(workers).fill(Math.max(this.minChunk, Math.round(INITIAL_CHUNK / cost)));
+    this.steals = new Array(workers).fill(0);
+    this.templates = new Map();
+    this.oldest = resume ? resume.doneBelow || 0 : 0;
+
+    const first = roller.current();
+    this.templates.set(first.index, first);
+    if (!resume) {
+      this._seed(first, [[nonceStart, NONCE_SPACE]]);
+      return;
+    }
+    for (let idx = 0; idx <= resume.rolled; idx++) {
+      const t = idx === 0 ? first : roller.next();
+      if (idx < (resume.doneBelow || 0)) continue;
+      this.templates.set(t.index, t);
+      const done = resume.completed.get(idx) || [];
+      this._seed(t, freeRanges(done, idx === 0 ? nonceStart : 0, NONCE_SPACE));
+    }
+  }
+
+  // Splits `ranges` of template t into equal shares, one per worker deque.
+  _seed(t, ranges = [[0, NONCE_SPACE]]) {
+    const total = ranges.reduce((n, [s, e]) => n + (e - s), 0);
+    const share = Math.ceil(total / this.size);
+    let i = 0;
+    let room = this.size === 1 ? Infinity : share;
+    for (let [start, end] of ranges) {
+      while (start < end) {
+        const take = Math.min(room, end - start);
+        this.deques[i].push({ template: t.index, start, end: start + take });
+        start += take;
+        room -= take;
+        if (room === 0) {
+          i++;
+          room = i === this.size - 1 ? Infinity : share;
+        }
+      }
+    }
+  }
+
+  // Newest rolled template, i.e. the extranonce/nTime cursor, plus the
+  // oldest template still queued or being hashed: every one below it is done.
+  cursor() {
+    const r = this.roller;
+    return { index: r.index, extranonce: r.extranonce, nTime: r.header.readUInt32LE(68), oldest: this.oldest };
+  }
+
+  // Feeds back how long worker i took for its last chunk.
+  record(i, hashes, ms) {
+    if (!hashes || !(ms > 0)) return;
+    const rate = hashes * 1000 / ms;
+    this.rates[i] = this.rates[i] ? this.rates[i] + RATE_ALPHA * (rate - this.rates[i]) : rate;
+    const chunk = Math.round(this.rates[i] * this.targetChunkMs / 1000);
+    this.chunks[i] = Math.min(MAX_CHUNK, Math.max(this.minChunk, chunk));
+  }
+
+  // Keeps the measured per-worker rates and chunk sizes of the previous job's
+  // scheduler, so a job switch does not restart chunk sizing from scratch.
+  adopt(prev) {
+    if (prev.size !== this.size || !prev.chunks) return;
+    this.rates = prev.rates.slice();
+    this.chunks = prev.chunks.map(c => Math.max(this.minChunk, c));
+  }
+
+  _steal(thief) {
+    let victim = -1;
+    let most = 0;
+    for (let i = 0; i < this.size; i++) {
+      if (i === thief) continue;
+      const left = this.deques[i].reduce((n, r) => n + (r.end - r.start), 0);
+      if (left > most) { most = left; victim = i; }
+    }
+    if (victim < 0) return false;
+
+    // Take the back half of the victim's last range (or the whole range when small).
+    const dq = this.deques[victim];
+    const last = dq[dq.length - 1];
+    const size = last.end - last.start;
+    if (size <= this.chunks[thief] * 2) {
+      this.deques[thief].push(dq.pop());
+    } else {
+      const mid = last.start + Math.floor(size / 2);
+      this.deques[thief].push({ template: last.template, start: mid, end: last.end });
+      last.end = mid;
+    }
+    this.steals[thief]++;
+    return true;
+  }
+
+  // Next chunk for worker i: own deque, else steal, else roll a new template.
+  next(i) {
+    const dq = this.deques[i];
+    if (!dq.length && !this._steal(i)) {
+      const t = this.roller.next();
+      this.templates.set(t.index, t);
+      this._seed(t);
+    }
+    const range = dq[0];
+    const end = Math.min(range.end, range.start + this.chunks[i]);
+    const unit = { template: this.templates.get(range.template), start: range.start, end };
+    range.start = end;
+    if (range.start >= range.end) dq.shift();
+    return unit;
+  }
+
+  // Drops templates older than anything queued or in `live` (indices still being hashed).
+  prune(live) {
+    let oldest = Infinity;
+    for (const dq of this.deques) for (const r of dq) oldest = Math.min(oldest, r.template);
+    for (const idx of live) oldest = Math.min(oldest, idx);
+    if (oldest !== Infinity) this.oldest = oldest;
+    for (const idx of this.templates.keys()) {
+      if (idx < oldest) this.templates.delete(idx);
+    }
+  }
+
+  workerStats() {
+    return this.rates.map((rate, i) => ({
+      worker: i,
+      hashrate: Math.round(rate),
+      chunk: this.chunks[i],
+      steals: this.steals[i]
+    }));
+  }
+}
+
+module.exports = { NonceScheduler, TARGET_CHUNK_MS };
@@ -0,0 +1,148 @@
+const { NONCE_SPACE } = require('./nonce_search');
+
+const DEFAULT_CHUNK = 1 << 16;
+const MIN_CHUNK = 1 << 6;
+const RATE_ALPHA = 0.3;
+
+// mulberry32: small seeded PRNG, enough to pick the chunk permutations.
+function mulberry32(seed) {
+  let a = seed >>> 0;
+  return () => {
+    a = (a + 0x6d2b79f5) >>> 0;
+    let t = a;
+    t = Math.imul(t ^ (t >>> 15), t | 1);
+    t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+// Inverse of an odd a modulo 2^bits.
+function inverseOdd(a, bits) {
+  const mod = 1n << BigInt(bits);
+  let x = BigInt(a);
+  for (let i = 0; i < 6; i++) x = (x * (2n - BigInt(a) * x)) % mod;
+  return Number(((x % mod) + mod) % mod);
+}
+
+// Deterministic counterpart of NonceScheduler (same interface, so WorkerPool
+// can use either). The search order is fixed by the seed alone: sequence
+// number s is chunk perm_t(s mod C) of template t = floor(s / C), where C is
+// the number of fixed-size chunks per template and perm_t is a seeded affine
+// permutation. Workers take sequence numbers in turn; which worker hashes a
+// chunk, and when, does not matter.
+//
+// The solution is the share with the lowest sequence number (lowest nonce
+// within the chunk), and it is only declared once every earlier chunk has
+// been hashed. Two runs with the same seed, header, target and chunk size
+// therefore find the same share after the same canonical hash count
+// (chunks before it plus its offset), whatever the thread count or timing.
+class SeededScheduler {
+  constructor({ workers, roller, seed = 0, chunk = DEFAULT_CHUNK }) {
+    if (!(chunk >= MIN_CHUNK && chunk <= NONCE_SPACE && Number.isInteger(Math.log2(chunk)))) {
+      throw new RangeError(`chunk must be a power of two in [${MIN_CHUNK}, 2^32]`);
+    }
+    this.size = workers;
+    this.roller = roller;
+    this.seed = seed >>> 0;
+    this.chunk = chunk;
+    this.count = NONCE_SPACE / chunk;
+    this.bits = Math.log2(this.count);
+    this.seq = 0;
+    this.rates = new Array(workers).fill(0);
+    this.perms = new Map();
+    this.templates = new Map();
+    this.rolled = roller.current();
+    this.templates.set(this.rolled.index, this.rolled);
+
+    this.low = 0; // every sequence number below this is hashed
+    this.completed = new Set();
+    this.candidates = [];
+    this.solution = null;
+  }
+
+  // Affine permutation k -> (a*k + b) mod C for template t, and its inverse.
+  _perm(t) {
+    let p = this.perms.get(t);
+    if (!p) {
+      const rand = mulberry32(this.seed ^ Math.imul(t + 1, 0x9e3779b9));
+      const a = (Math.floor(rand() * this.count) | 1) % this.count || 1;
+      const b = Math.floor(rand() * this.count);
+      p = { a, b, inv: inverseOdd(a, this.bits) };
+      this.perms.set(t, p);
+    }
+    return p;
+  }
+
+  _chunkOf(seq) {
+    const t = Math.floor(seq / this.count);
+    const { a, b } = this._perm(t);
+    return { template: t, index: (a * (seq % this.count) + b) % this.count };
+  }
+
+  // Sequence number of the chunk holding `nonce` in template t.
+  seqOf(t, nonce) {
+    const { b, inv } = this._perm(t);
+    const index = Math.floor(nonce / this.chunk);
+    const k = (inv * ((index - b + this.count) % this.count)) % this.count;
+    return t * this.count + k;
+  }
+
+  cursor() {
+    const r = this.roller;
+    return { index: r.index, extranonce: r.extranonce, nTime: r.header.readUInt32LE(68) };
+  }
+
+  // Chunk sizes are fixed; timings are only kept for workerStats.
+  record(i, hashes, ms) {
+    if (!hashes || !(ms > 0)) return;
+    const rate = hashes * 1000 / ms;
+    this.rates[i] = this.rates[i] ? this.rates[i] + RATE_ALPHA * (rate - this.rates[i]) : rate;
+  }
+
+  adopt() {}
+
+  next() {
+    const { template, index } = this._chunkOf(this.seq++);
+    while (this.rolled.index < template) {
+      this.rolled = this.roller.next();
+      this.templates.set(this.rolled.index, this.rolled);
+    }
+    const start = index * this.chunk;
+    return { template: this.templates.get(template), start, end: start + this.chunk };
+  }
+
+  prune(live) {
+    const oldest = Math.min(...live, this.rolled.index);
+    for (const idx of this.templates.keys()) {
+      if (idx < oldest) this.templates.delete(idx);
+    }
+  }
+
+  // A chunk was fully hashed (WorkerPool's onChunkDone).
+  complete(t, start) {
+    this.completed.add(this.seqOf(t, start));
+    while (this.completed.delete(this.low)) this.low++;
+    return this._settle();
+  }
+
+  // A share was found; returns the solution once it is settled.
+  offer({ template, nonce, hash, header }) {
+    const seq = this.seqOf(template, nonce);
+    const offset = nonce - Math.floor(nonce / this.chunk) * this.chunk;
+    this.candidates.push({ seq, template, nonce, hash, header, hashes: seq * this.chunk + offset + 1 });
+    return this._settle();
+  }
+
+  _settle() {
+    if (this.solution || !this.candidates.length) return this.solution;
+    const best = this.candidates.reduce((x, y) => (y.seq < x.seq || (y.seq === x.seq && y.nonce < x.nonce) ? y : x));
+    if (best.seq <= this.low) this.solution = best;
+    return this.solution;
+  }
+
+  workerStats() {
+    return this.rates.map((rate, i) => ({ worker: i, hashrate: Math.round(rate), chunk: this.chunk, steals: 0 }));
+  }
+}
+
+module.exports = { SeededScheduler, mulberry32, DEFAULT_CHUNK };
@@ -0,0 +1,90 @@
+// Plain SHA-256 compression over preallocated word arrays.
+// Used by the nonce search so the hot loop never allocates.
+const crypto = require('crypto');
+
+const K = new Uint32Array([
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+]);
+
+const IV = new Uint32Array([
+  0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+]);
+
+const W = new Uint32Array(64);
+
+// Runs one compression of `block` (16 big-endian words) into `state` (8 words).
+function compress(state, block) {
+  for (let i = 0; i < 16; i++) W[i] = block[i];
+  for (let i = 16; i < 64; i++) {
+    const w15 = W[i - 15];
+    const w2 = W[i - 2];
+    const s0 = ((w15 >>> 7) | (w15 << 25)) ^ ((w15 >>> 18) | (w15 << 14)) ^ (w15 >>> 3);
+    const s1 = ((w2 >>> 17) | (w2 << 15)) ^ ((w2 >>> 19) | (w2 << 13)) ^ (w2 >>> 10);
+    W[i] = (W[i - 16] + s0 + W[i - 7] + s1) | 0;
+  }
+
+  let a = state[0] | 0, b = state[1] | 0, c = state[2] | 0, d = state[3] | 0;
+  let e = state[4] | 0, f = state[5] | 0, g = state[6] | 0, h = state[7] | 0;
+
+  for (let i = 0; i < 64; i++) {
+    const S1 = ((e >>> 6) | (e << 26)) ^ ((e >>> 11) | (e << 21)) ^ ((e >>> 25) | (e << 7));
+    const ch = (e & f) ^ (~e & g);
+    const t1 = (h + S1 + ch + K[i] + W[i]) | 0;
+    const S0 = ((a >>> 2) | (a << 30)) ^ ((a >>> 13) | (a << 19)) ^ ((a >>> 22) | (a << 10));
+    const maj = (a & b) ^ (a & c) ^ (b & c);
+    const t2 = (S0 + maj) | 0;
+    h = g; g = f; f = e; e = (d + t1) | 0;
+    d = c; c = b; b = a; a = (t1 + t2) | 0;
+  }
+
+  state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+  state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+function bswap32(x) {
+  return (((x & 0xff) << 24) | ((x & 0xff00) << 8) | ((x >>> 8) & 0xff00) | (x >>> 24)) >>> 0;
+}
+
+// Loads 16 big-endian words from `buf` at `offset` into `out`.
+function readBlock(buf, offset, out) {
+  for (let i = 0; i < 16; i++) out[i] = buf.readUInt32BE(offset + i * 4);
+  return out;
+}
+
+// Writes the 8 state words as a 32-byte big-endian digest.
+function writeDigest(state, out, offset = 0) {
+  for (let i = 0; i < 8; i++) out.writeUInt32BE(state[i] >>> 0, offset + i * 4);
+  return out;
+}
+
+// SHA-256 of a message whose first `prefixLength` bytes (a multiple of 64)
+// are already compressed into `midstate`; only `tail` and the padding are
+// hashed. Returns the 32-byte digest.
+function sha256From(midstate, prefixLength, tail) {
+  const total = prefixLength + tail.length;
+  const blocks = Math.ceil((tail.length + 9) / 64);
+  const padded = Buffer.alloc(blocks * 64);
+  tail.copy(padded);
+  padded[tail.length] = 0x80;
+  padded.writeUInt32BE(Math.floor(total / 0x20000000), padded.length - 8);
+  padded.writeUInt32BE((total * 8) >>> 0, padded.length - 4);
+  const state = Uint32Array.from(midstate);
+  const block = new Uint32Array(16);
+  for (let off = 0; off < padded.length; off += 64) compress(state, readBlock(padded, off, block));
+  return writeDigest(state, Buffer.alloc(32));
+}
+
+// One-shot double SHA-256 for everything outside the hot loop.
+function sha256d(data) {
+  const first = crypto.createHash('sha256').update(data).digest();
+  return crypto.createHash('sha256').update(first).digest();
+}
+
+module.exports = { IV, compress, bswap32, readBlock, writeDigest, sha256From, sha256d };
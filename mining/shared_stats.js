@@ -0,0 +1,102 @@
+// Per-worker stats in a SharedArrayBuffer, so workers publish progress without
+// postMessage. Each worker owns one 64-byte slot (its own cache line, so
+// workers never write to a line another core is writing) and is the only
+// writer to it; the main thread reads every slot on its stats tick.
+//
+// Slot layout, 64-bit words:
+//   0 hashes   total hashes done by this worker
+//   1 shares   shares found
+//   2 best     top 64 bits of the lowest share hash so far (all ones = none)
+//   3 batch    current slice size
+//   4 wasted   hashes spent on a job after it was replaced
+//   5 switches job switches this worker went through
+//   6 switchUs how long the last switch took to reach this worker, in µs
+//   7          padding to the cache line
+const SLOT_BYTES = 64;
+const WORDS = SLOT_BYTES / 8;
+const HASHES = 0;
+const SHARES = 1;
+const BEST = 2;
+const BATCH = 3;
+const WASTED = 4;
+const SWITCHES = 5;
+const SWITCH_US = 6;
+const NO_SHARE = 0xffffffffffffffffn;
+
+// Difficulty 1 target is 0xffff << 208, so for a hash whose top 64 bits are
+// `top` the difficulty is about 0xffff << 16 / top.
+function difficultyFromTop(top) {
+  if (top === NO_SHARE) return 0;
+  return 0xffff * 65536 / Math.max(1, Number(top));
+}
+
+// Top 64 bits of a hash given as displayed (big-endian) hex.
+function hashTop(hashHex) {
+  return BigInt(`0x${hashHex.slice(0, 16)}`);
+}
+
+class SharedStats {
+  // buffer: an existing SharedArrayBuffer (worker side) or none to allocate.
+  constructor(slots, buffer) {
+    this.slots = slots;
+    this.buffer = buffer || new SharedArrayBuffer(slots * SLOT_BYTES);
+    this.words = new BigUint64Array(this.buffer);
+    if (!buffer) {
+      for (let i = 0; i < slots; i++) this.words[i * WORDS + BEST] = NO_SHARE;
+    }
+  }
+
+  // Writer side (one worker per slot).
+  addHashes(slot, n) {
+    Atomics.add(this.words, slot * WORDS + HASHES, BigInt(n));
+  }
+
+  setBatch(slot, n) {
+    Atomics.store(this.words, slot * WORDS + BATCH, BigInt(n));
+  }
+
+  addShare(slot, hashHex) {
+    const base = slot * WORDS;
+    Atomics.add(this.words, base + SHARES, 1n);
+    const top = hashTop(hashHex);
+    if (top < Atomics.load(this.words, base + BEST)) Atomics.store(this.words, base + BEST, top);
+  }
+
+  addSwitch(slot, wasted, ms) {
+    const base = slot * WORDS;
+    Atomics.add(this.words, base + WASTED, BigInt(wasted));
+    Atomics.add(this.words, base + SWITCHES, 1n);
+    Atomics.store(this.words, base + SWITCH_US, BigInt(Math.max(0, Math.round(ms * 1000))));
+  }
+
+  // Reader side.
+  read(slot) {
+    const base = slot * WORDS;
+    return {
+      hashes: Number(Atomics.load(this.words, base + HASHES)),
+      shares: Number(Atomics.load(this.words, base + SHARES)),
+      bestDifficulty: difficultyFromTop(Atomics.load(this.words, base + BEST)),
+      batch: Number(Atomics.load(this.words, base + BATCH)),
+      wastedHashes: Number(Atomics.load(this.words, base + WASTED)),
+      switches: Number(Atomics.load(this.words, base + SWITCHES)),
+      switchMs: Number(Atomics.load(this.words, base + SWITCH_US)) / 1000
+    };
+  }
+
+  // Sums over all slots; bestDifficulty is the best of any worker and
+  // switchMs the slowest worker's last switch.
+  total() {
+    const sum = { hashes: 0, shares: 0, bestDifficulty: 0, wastedHashes: 0, switchMs: 0 };
+    for (let i = 0; i < this.slots; i++) {
+      const s = this.read(i);
+      sum.hashes += s.hashes;
+      sum.shares += s.shares;
+      sum.bestDifficulty = Math.max(sum.bestDifficulty, s.bestDifficulty);
+      sum.wastedHashes += s.wastedHashes;
+      sum.switchMs = Math.max(sum.switchMs, s.switchMs);
+    }
+    return sum;
+  }
+}
+
+module.exports = { SharedStats, SLOT_BYTES, difficultyFromTop, hashTop };
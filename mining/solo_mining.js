@@ -0,0 +1,9 @@
+let soloConfig = { nodeUrl: '', rpcUser: '', rpcPassword: '' };
+
+module.exports = {
+  configure: (cfg) => {
+    soloConfig = { ...soloConfig, ...cfg };
+    return { ok: true, soloConfig };
+  },
+  getConfig: () => soloConfig
+};
\ No newline at end of file
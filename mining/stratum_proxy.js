@@ -0,0 +1,337 @@
+// Local Stratum v1 proxy: one upstream pool session shared by many
+// downstream miners (built-in, external ones from external_miners.js, or
+// other machines on the LAN).
+//
+// The upstream extranonce2 space is split. Each downstream gets a slot
+// number of `prefixBytes` appended to its extranonce1 and rolls the rest, so
+// shares of different downstreams never collide and the pool sees a single
+// miner. Notifies, difficulty and extranonce changes are relayed as they
+// arrive (a downstream that did not send mining.extranonce.subscribe is
+// dropped on an extranonce change, to reconnect with the new one); submits are
+// gathered for `batchMs` (default: one event-loop turn) and written
+// upstream in one go. 'idle' is emitted when no downstream is connected for
+// `idleMs`, after start or after the last one left (so a miner restarting or
+// reconnecting finds the proxy still there).
+//
+//   node mining/stratum_proxy.js <pool url> <user> [password] [port] [host]
+const net = require('net');
+const { EventEmitter } = require('events');
+const { performance } = require('perf_hooks');
+const { StratumClient } = require('./pool_mining');
+
+class StratumProxy extends EventEmitter {
+  // url/user/password: the upstream pool session
+  // host/port:         where downstream miners connect (0 = any free port)
+  // prefixBytes:       extranonce2 bytes taken per downstream slot
+  // requestTimeoutMs:  how long an upstream submit waits for the pool
+  // idleMs:            how long the proxy waits without downstreams before 'idle'
+  constructor({
+    url, user, password = 'x', port = 0, host = '127.0.0.1', prefixBytes = 2, batchMs = 0, requestTimeoutMs, idleMs = 60000
+  }) {
+    super();
+    this.upstreamUrl = url;
+    this.user = user;
+    this.password = password;
+    this.requestTimeoutMs = requestTimeoutMs;
+    this.idleMs = idleMs;
+    this.idleTimer = null;
+    this.port = port;
+    this.host = host;
+    this.prefixBytes = prefixBytes;
+    this.batchMs = batchMs;
+    this.downstreams = new Set();
+    this.slots = new Set();
+    this.notifyParams = null;
+    this.queue = [];
+    this.flushing = false;
+    this.batches = { count: 0, shares: 0 };
+    this.closed = false;
+  }
+
+  // Opens the upstream session, then listens for downstreams. Resolves with
+  // the downstream URL.
+  async start() {
+    if (/^stratum2\+tcp:/.test(this.upstreamUrl)) throw new Error('The proxy relays Stratum v1 pools only');
+    const up = this.upstream = new StratumClient({
+      url: this.upstreamUrl, user: this.user, password: this.password, requestTimeoutMs: this.requestTimeoutMs
+    });
+    up.on('notify', (params) => {
+      this.notifyParams = params;
+      this._broadcast('mining.notify', params);
+    });
+    up.on('difficulty', d => this._broadcast('mining.set_difficulty', [d]));
+    up.on('extranonce', () => this._onExtranonce());
+    up.on('error', () => {});
+    up.on('close', () => this.stop());
+    await up.connect();
+    if (up.extranonce2Size <= this.prefixBytes) {
+      this.stop();
+      throw new Error(`Pool extranonce2 (${up.extranonce2Size} bytes) leaves no room for ${this.prefixBytes}-byte slots`);
+    }
+    this.server = net.createServer(socket => this._onConnection(socket));
+    await new Promise((resolve, reject) => {
+      this.server.once('error', reject);
+      this.server.listen(this.port, this.host, resolve);
+    });
+    this.port = this.server.address().port;
+    // A miner that fails before connecting would otherwise leave the pool
+    // session open for good.
+    this._armIdle();
+    return this.url;
+  }
+
+  // (Re)starts the grace period after which a proxy without downstreams is idle.
+  _armIdle() {
+    clearTimeout(this.idleTimer);
+    if (this.closed) return;
+    this.idleTimer = setTimeout(() => {
+      if (!this.downstreams.size) this.emit('idle');
+    }, this.idleMs);
+  }
+
+  get url() {
+    return `stratum+tcp://${this.host === '0.0.0.0' ? '127.0.0.1' : this.host}:${this.port}`;
+  }
+
+  // Downstreams roll what is left of the pool's extranonce2.
+  get extranonce2Size() {
+    return this.upstream.extranonce2Size - this.prefixBytes;
+  }
+
+  stop() {
+    if (this.closed) return;
+    this.closed = true;
+    clearTimeout(this.idleTimer);
+    for (const d of this.downstreams) d.socket.destroy();
+    if (this.server) this.server.close();
+    if (this.upstream) this.upstream.close();
+    this.emit('close');
+  }
+
+  _freeSlot() {
+    const max = 2 ** (8 * this.prefixBytes);
+    for (let i = 0; i < max; i++) if (!this.slots.has(i)) return i;
+    return -1;
+  }
+
+  _onConnection(socket) {
+    const slot = this._freeSlot();
+    if (slot < 0) {
+      socket.destroy();
+      return;
+    }
+    this.slots.add(slot);
+    clearTimeout(this.idleTimer);
+    const prefix = Buffer.alloc(this.prefixBytes);
+    prefix.writeUIntBE(slot, 0, this.prefixBytes);
+    const d = {
+      socket,
+      slot,
+      prefix: prefix.toString('hex'),
+      user: null,
+      authorized: false,
+      extranonceSubscribed: false,
+      shares: { submitted: 0, accepted: 0, rejected: 0, totalMs: 0, lastError: null },
+      since: Date.now()
+    };
+    this.downstreams.add(d);
+    socket.setNoDelay(true);
+    socket.setEncoding('utf8');
+    let buffer = '';
+    socket.on('data', (chunk) => {
+      buffer += chunk;
+      let nl;
+      while ((nl = buffer.indexOf('\n')) >= 0) {
+        const line = buffer.slice(0, nl).trim();
+        buffer = buffer.slice(nl + 1);
+        if (!line) continue;
+        try {
+          this._onRequest(d, JSON.parse(line));
+        } catch (e) {
+          socket.destroy();
+          return;
+        }
+      }
+    });
+    socket.on('error', () => {});
+    socket.on('close', () => {
+      this.downstreams.delete(d);
+      this.slots.delete(slot);
+      if (!this.downstreams.size) this._armIdle();
+    });
+  }
+
+  _send(d, msg) {
+    if (!d.socket.destroyed) d.socket.write(`${JSON.stringify(msg)}\n`);
+  }
+
+  _broadcast(method, params) {
+    for (const d of this.downstreams) if (d.authorized) this._send(d, { id: null, method, params });
+  }
+
+  _onRequest(d, { id, method, params = [] }) {
+    if (method === 'mining.subscribe') {
+      const extranonce1 = this.upstream.extranonce1 + d.prefix;
+      this._send(d, { id, result: [[['mining.set_difficulty', extranonce1], ['mining.notify', extranonce1]], extranonce1, this.extranonce2Size], error: null });
+    } else if (method === 'mining.authorize') {
+      d.authorized = true;
+      d.user = params[0];
+      this._send(d, { id, result: true, error: null });
+      this._send(d, { id: null, method: 'mining.set_difficulty', params: [this.upstream.difficulty] });
+      if (this.notifyParams) this._send(d, { id: null, method: 'mining.notify', params: this.notifyParams });
+    } else if (method === 'mining.extranonce.subscribe') {
+      d.extranonceSubscribed = true;
+      this._send(d, { id, result: true, error: null });
+    } else if (method === 'mining.submit') {
+      this._submit(d, id, params);
+    } else {
+      this._send(d, { id, result: null, error: [20, `Unsupported method ${method}`, null] });
+    }
+  }
+
+  // The pool moved the extranonce: every slot keeps its prefix behind the
+  // new extranonce1.
+  _onExtranonce() {
+    if (this.upstream.extranonce2Size <= this.prefixBytes) {
+      this.stop();
+      return;
+    }
+    for (const d of this.downstreams) {
+      if (!d.extranonceSubscribed) d.socket.destroy();
+      else this._send(d, { id: null, method: 'mining.set_extranonce', params: [this.upstream.extranonce1 + d.prefix, this.extranonce2Size] });
+    }
+  }
+
+  // Rewrites a downstream share into the pool's extranonce2 space and queues
+  // it; the pool's answer goes back to the downstream.
+  _submit(d, id, [, jobId, en2, ntime, nonce]) {
+    if (!d.authorized || typeof en2 !== 'string' || en2.length !== 2 * this.extranonce2Size) {
+      this._send(d, { id, result: null, error: [20, 'Bad extranonce2', null] });
+      return;
+    }
+    const sent = performance.now();
+    d.shares.submitted++;
+    this._enqueue([this.user, jobId, d.prefix + en2, ntime, nonce]).then(({ accepted, error }) => {
+      d.shares.totalMs += performance.now() - sent;
+      if (accepted) d.shares.accepted++;
+      else {
+        d.shares.rejected++;
+        d.shares.lastError = error;
+      }
+      this._send(d, { id, result: accepted, error: accepted ? null : [20, error, null] });
+    });
+  }
+
+  _enqueue(params) {
+    return new Promise((resolve) => {
+      this.queue.push({ params, resolve });
+      if (this.flushing) return;
+      this.flushing = true;
+      const flush = () => this._flush();
+      if (this.batchMs > 0) setTimeout(flush, this.batchMs);
+      else setImmediate(flush);
+    });
+  }
+
+  // Every queued submit in one socket write.
+  _flush() {
+    const batch = this.queue;
+    this.queue = [];
+    this.flushing = false;
+    if (this.closed) {
+      for (const s of batch) s.resolve({ accepted: false, error: 'Pool connection closed' });
+      return;
+    }
+    const socket = this.upstream.socket;
+    socket.cork();
+    for (const { params, resolve } of batch) {
+      this.upstream.request('mining.submit', params).then(
+        result => resolve({ accepted: result === true, error: result === true ? null : 'rejected' }),
+        err => resolve({ accepted: false, error: err.message })
+      );
+    }
+    socket.uncork();
+    this.batches.count++;
+    this.batches.shares += batch.length;
+  }
+
+  // Upstream session, submit batching and acceptance per downstream.
+  stats() {
+    return {
+      url: this.url,
+      upstream: {
+        url: this.upstreamUrl,
+        difficulty: this.upstream ? this.upstream.difficulty : null,
+        jobId: this.upstream && this.upstream.job ? this.upstream.job.jobId : null,
+        extranonce2Size: this.upstream ? this.upstream.extranonce2Size : null
+      },
+      batches: {
+        count: this.batches.count,
+        shares: this.batches.shares,
+        avgSize: this.batches.count ? +(this.batches.shares / this.batches.count).toFixed(2) : 0
+      },
+      downstreams: [...this.downstreams].map(d => ({
+        slot: d.slot,
+        user: d.user,
+        address: d.socket.remoteAddress,
+        connectedSec: Math.floor((Date.now() - d.since) / 1000),
+        submitted: d.shares.submitted,
+        accepted: d.shares.accepted,
+        rejected: d.shares.rejected,
+        acceptRate: d.shares.submitted ? +(d.shares.accepted / d.shares.submitted).toFixed(4) : null,
+        avgLatencyMs: d.shares.accepted + d.shares.rejected
+          ? +(d.shares.totalMs / (d.shares.accepted + d.shares.rejected)).toFixed(2)
+          : 0,
+        lastError: d.shares.lastError
+      }))
+    };
+  }
+}
+
+// The app's proxies, one per pool and user, keyed 'url|user' (the value is
+// the start promise, so concurrent starts share it). Miners for the same
+// pool share one; a proxy stops once it has had no downstream for idleMs.
+const proxies = new Map();
+
+function ensureProxy(options) {
+  const key = `${options.url}|${options.user}`;
+  if (proxies.has(key)) return proxies.get(key);
+  const proxy = new StratumProxy(options);
+  proxy.on('close', () => proxies.delete(key));
+  proxy.on('idle', () => proxy.stop());
+  const started = proxy.start().then(() => proxy, (e) => {
+    proxy.stop();
+    proxies.delete(key);
+    throw e;
+  });
+  proxies.set(key, started);
+  return started;
+}
+
+// Stops every proxy (resolves once those still starting are stopped too).
+function stopProxy() {
+  const all = [...proxies.values()].map(started => started.then(proxy => proxy.stop(), () => {}));
+  proxies.clear();
+  return Promise.all(all);
+}
+
+// Stats of every running proxy.
+async function proxyStats() {
+  const running = await Promise.all([...proxies.values()].map(p => p.catch(() => null)));
+  return running.filter(Boolean).map(proxy => proxy.stats());
+}
+
+if (require.main === module) {
+  const [url, user, password = 'x', port = 3334, host = '0.0.0.0'] = process.argv.slice(2);
+  const proxy = new StratumProxy({ url, user, password, port: Number(port), host });
+  proxy.start().then((downstream) => {
+    console.log(`proxy for ${url} on ${downstream}`);
+    setInterval(() => console.log(JSON.stringify(proxy.stats())), 30000);
+  }, (e) => {
+    console.error(e.message);
+    process.exit(1);
+  });
+  proxy.on('close', () => process.exit(1));
+}
+
+module.exports = { StratumProxy, ensureProxy, stopProxy, proxyStats };
@@ -0,0 +1,200 @@
+// Stratum v2 mining sub-protocol messages and their binary framing (the
+// client is Sv2Client in pool_mining.js).
+//
+// Frame: extension_type U16 (bit 15 set for channel messages) | msg_type U8 |
+// msg_length U24 | payload, little-endian throughout. Message layouts are
+// declared once in MESSAGES and encoded/decoded from there. Connections are
+// plain TCP: the spec's Noise handshake is not implemented, so this is for
+// pools on the local machine or a trusted network.
+const HEADER_BYTES = 6;
+const CHANNEL_BIT = 0x8000;
+const PROTOCOL_MINING = 0;
+const VERSION = 2;
+// SetupConnection flag: the client only takes standard (header-only) jobs.
+const REQUIRES_STANDARD_JOBS = 1;
+
+// Field types: fixed-width integers, U256/B32 as 32 raw bytes, length-
+// prefixed strings/byte arrays, a U256 sequence and an optional U32.
+const TYPES = {
+  u8: { size: () => 1, write: (b, o, v) => b.writeUInt8(v, o), read: (b, o) => [b.readUInt8(o), 1] },
+  bool: { size: () => 1, write: (b, o, v) => b.writeUInt8(v ? 1 : 0, o), read: (b, o) => [b[o] === 1, 1] },
+  u16: { size: () => 2, write: (b, o, v) => b.writeUInt16LE(v, o), read: (b, o) => [b.readUInt16LE(o), 2] },
+  u32: { size: () => 4, write: (b, o, v) => b.writeUInt32LE(v >>> 0, o), read: (b, o) => [b.readUInt32LE(o), 4] },
+  u64: { size: () => 8, write: (b, o, v) => b.writeBigUInt64LE(BigInt(v), o), read: (b, o) => [b.readBigUInt64LE(o), 8] },
+  f32: { size: () => 4, write: (b, o, v) => b.writeFloatLE(v, o), read: (b, o) => [b.readFloatLE(o), 4] },
+  u256: { size: () => 32, write: (b, o, v) => Buffer.from(v).copy(b, o, 0, 32), read: (b, o) => [Buffer.from(b.subarray(o, o + 32)), 32] },
+  str0_255: lengthPrefixed(1, 255, true),
+  b0_32: lengthPrefixed(1, 32, false),
+  b0_255: lengthPrefixed(1, 255, false),
+  b0_64k: lengthPrefixed(2, 0xffff, false),
+  seq0_255_u256: {
+    size: v => 1 + 32 * v.length,
+    write: (b, o, v) => {
+      b.writeUInt8(v.length, o);
+      v.forEach((h, i) => Buffer.from(h).copy(b, o + 1 + 32 * i, 0, 32));
+    },
+    read: (b, o) => {
+      const n = b[o];
+      const out = [];
+      for (let i = 0; i < n; i++) out.push(Buffer.from(b.subarray(o + 1 + 32 * i, o + 33 + 32 * i)));
+      return [out, 1 + 32 * n];
+    }
+  },
+  opt_u32: {
+    size: v => (v === null || v === undefined ? 1 : 5),
+    write: (b, o, v) => {
+      const some = v !== null && v !== undefined;
+      b.writeUInt8(some ? 1 : 0, o);
+      if (some) b.writeUInt32LE(v >>> 0, o + 1);
+    },
+    read: (b, o) => (b[o] ? [b.readUInt32LE(o + 1), 5] : [null, 1])
+  }
+};
+
+function lengthPrefixed(prefix, max, text) {
+  const bytes = v => (text ? Buffer.from(String(v), 'utf8') : Buffer.from(v));
+  return {
+    size: v => prefix + bytes(v).length,
+    write: (b, o, v) => {
+      const data = bytes(v);
+      if (data.length > max) throw new RangeError(`field longer than ${max} bytes`);
+      if (prefix === 1) b.writeUInt8(data.length, o);
+      else b.writeUInt16LE(data.length, o);
+      data.copy(b, o + prefix);
+    },
+    read: (b, o) => {
+      const n = prefix === 1 ? b[o] : b.readUInt16LE(o);
+      const data = Buffer.from(b.subarray(o + prefix, o + prefix + n));
+      return [text ? data.toString('utf8') : data, prefix + n];
+    }
+  };
+}
+
+// Common and mining sub-protocol messages used here.
+const MESSAGES = {
+  SetupConnection: { type: 0x00, fields: [
+    ['protocol', 'u8'], ['minVersion', 'u16'], ['maxVersion', 'u16'], ['flags', 'u32'],
+    ['endpointHost', 'str0_255'], ['endpointPort', 'u16'], ['vendor', 'str0_255'],
+    ['hardwareVersion', 'str0_255'], ['firmware', 'str0_255'], ['deviceId', 'str0_255']
+  ] },
+  SetupConnectionSuccess: { type: 0x01, fields: [['usedVersion', 'u16'], ['flags', 'u32']] },
+  SetupConnectionError: { type: 0x02, fields: [['flags', 'u32'], ['errorCode', 'str0_255']] },
+  OpenStandardMiningChannel: { type: 0x10, fields: [
+    ['requestId', 'u32'], ['userIdentity', 'str0_255'], ['nominalHashRate', 'f32'], ['maxTarget', 'u256']
+  ] },
+  OpenStandardMiningChannelSuccess: { type: 0x11, fields: [
+    ['requestId', 'u32'], ['channelId', 'u32'], ['target', 'u256'], ['extranoncePrefix', 'b0_32'], ['groupChannelId', 'u32']
+  ] },
+  OpenMiningChannelError: { type: 0x12, fields: [['requestId', 'u32'], ['errorCode', 'str0_255']] },
+  OpenExtendedMiningChannel: { type: 0x13, fields: [
+    ['requestId', 'u32'], ['userIdentity', 'str0_255'], ['nominalHashRate', 'f32'], ['maxTarget', 'u256'],
+    ['minExtranonceSize', 'u16']
+  ] },
+  OpenExtendedMiningChannelSuccess: { type: 0x14, fields: [
+    ['requestId', 'u32'], ['channelId', 'u32'], ['target', 'u256'], ['extranonceSize', 'u16'], ['extranoncePrefix', 'b0_32']
+  ] },
+  NewMiningJob: { type: 0x15, channel: true, fields: [
+    ['channelId', 'u32'], ['jobId', 'u32'], ['minNtime', 'opt_u32'], ['version', 'u32'], ['merkleRoot', 'u256']
+  ] },
+  SubmitSharesStandard: { type: 0x1a, channel: true, fields: [
+    ['channelId', 'u32'], ['sequenceNumber', 'u32'], ['jobId', 'u32'], ['nonce', 'u32'], ['ntime', 'u32'], ['version', 'u32']
+  ] },
+  SubmitSharesExtended: { type: 0x1b, channel: true, fields: [
+    ['channelId', 'u32'], ['sequenceNumber', 'u32'], ['jobId', 'u32'], ['nonce', 'u32'], ['ntime', 'u32'], ['version', 'u32'],
+    ['extranonce', 'b0_32']
+  ] },
+  SubmitSharesSuccess: { type: 0x1c, channel: true, fields: [
+    ['channelId', 'u32'], ['lastSequenceNumber', 'u32'], ['newSubmitsAcceptedCount', 'u32'], ['newSharesSum', 'u64']
+  ] },
+  SubmitSharesError: { type: 0x1d, channel: true, fields: [
+    ['channelId', 'u32'], ['sequenceNumber', 'u32'], ['errorCode', 'str0_255']
+  ] },
+  NewExtendedMiningJob: { type: 0x1f, channel: true, fields: [
+    ['channelId', 'u32'], ['jobId', 'u32'], ['minNtime', 'opt_u32'], ['version', 'u32'], ['versionRollingAllowed', 'bool'],
+    ['merklePath', 'seq0_255_u256'], ['coinbaseTxPrefix', 'b0_64k'], ['coinbaseTxSuffix', 'b0_64k']
+  ] },
+  SetNewPrevHash: { type: 0x20, channel: true, fields: [
+    ['channelId', 'u32'], ['jobId', 'u32'], ['prevHash', 'u256'], ['minNtime', 'u32'], ['nbits', 'u32']
+  ] },
+  SetTarget: { type: 0x21, channel: true, fields: [['channelId', 'u32'], ['maximumTarget', 'u256']] }
+};
+
+const BY_TYPE = new Map(Object.entries(MESSAGES).map(([name, m]) => [m.type, name]));
+
+// One framed message.
+function encode(name, msg) {
+  const def = MESSAGES[name];
+  const sizes = def.fields.map(([field, type]) => TYPES[type].size(msg[field]));
+  const length = sizes.reduce((a, b) => a + b, 0);
+  const frame = Buffer.allocUnsafe(HEADER_BYTES + length);
+  frame.writeUInt16LE(def.channel ? CHANNEL_BIT : 0, 0);
+  frame.writeUInt8(def.type, 2);
+  frame.writeUIntLE(length, 3, 3);
+  let o = HEADER_BYTES;
+  def.fields.forEach(([field, type], i) => {
+    TYPES[type].write(frame, o, msg[field]);
+    o += sizes[i];
+  });
+  return frame;
+}
+
+// Payload of a known message type -> { name, msg }; unknown types give null.
+// Throws a RangeError when the payload is shorter than its fields.
+function decodePayload(type, payload) {
+  const name = BY_TYPE.get(type);
+  if (!name) return null;
+  const msg = {};
+  let o = 0;
+  for (const [field, t] of MESSAGES[name].fields) {
+    const [value, used] = TYPES[t].read(payload, o);
+    if (o + used > payload.length) throw new RangeError(`${name}: truncated ${field}`);
+    msg[field] = value;
+    o += used;
+  }
+  return { name, msg };
+}
+
+// Splits a byte stream into frames.
+class FrameDecoder {
+  constructor() {
+    this.buffer = Buffer.alloc(0);
+  }
+
+  // Returns the complete messages in chunk (plus whatever was buffered).
+  // Throws on a malformed frame; the connection is unusable after that.
+  push(chunk) {
+    this.buffer = this.buffer.length ? Buffer.concat([this.buffer, chunk]) : chunk;
+    const out = [];
+    while (this.buffer.length >= HEADER_BYTES) {
+      const length = this.buffer.readUIntLE(3, 3);
+      if (this.buffer.length < HEADER_BYTES + length) break;
+      const type = this.buffer[2];
+      const decoded = decodePayload(type, this.buffer.subarray(HEADER_BYTES, HEADER_BYTES + length));
+      if (decoded) out.push(decoded);
+      this.buffer = this.buffer.subarray(HEADER_BYTES + length);
+    }
+    return out;
+  }
+}
+
+// U256 targets go little-endian on the wire; ours are big-endian Buffers.
+function targetToWire(target) {
+  return Buffer.from(target).reverse();
+}
+
+function targetFromWire(u256) {
+  return Buffer.from(u256).reverse();
+}
+
+module.exports = {
+  FrameDecoder,
+  MESSAGES,
+  encode,
+  decodePayload,
+  targetToWire,
+  targetFromWire,
+  HEADER_BYTES,
+  PROTOCOL_MINING,
+  REQUIRES_STANDARD_JOBS,
+  VERSION
+};
@@ -0,0 +1,107 @@
+// System CPU load as seen by the idle-aware scheduler. On Linux it reads
+// /proc/stat (all-CPU jiffies), /proc/loadavg and /proc/<pid>/stat for miner
+// processes; elsewhere it falls back to os.cpus() times and os.loadavg().
+//
+// Each sample reports how much of the machine the *rest* of the system is
+// using: total busy time minus the miner's own CPU time (this process, which
+// includes the worker threads, or the external miner pids).
+const fs = require('fs');
+const os = require('os');
+
+const USER_HZ = 100;
+
+function readProcStat() {
+  try {
+    const line = fs.readFileSync('/proc/stat', 'utf8').split('\n', 1)[0];
+    const v = line.trim().split(/\s+/).slice(1).map(Number);
+    // user nice system idle iowait irq softirq steal
+    const idle = v[3] + (v[4] || 0);
+    const total = v.slice(0, 8).reduce((a, b) => a + (b || 0), 0);
+    return { busy: total - idle, total };
+  } catch {
+    return null;
+  }
+}
+
+function readCpusTimes() {
+  let busy = 0;
+  let total = 0;
+  for (const c of os.cpus()) {
+    const t = c.times;
+    const sum = t.user + t.nice + t.sys + t.idle + t.irq;
+    busy += sum - t.idle;
+    total += sum;
+  }
+  // os.cpus() reports ms; scale to USER_HZ ticks like /proc/stat.
+  return { busy: busy * USER_HZ / 1000, total: total * USER_HZ / 1000 };
+}
+
+function readLoadavg() {
+  try {
+    return Number(fs.readFileSync('/proc/loadavg', 'utf8').split(' ')[0]);
+  } catch {
+    return os.loadavg()[0];
+  }
+}
+
+// utime + stime of a process in USER_HZ ticks, 0 when it is gone.
+function readPidTicks(pid) {
+  try {
+    const stat = fs.readFileSync(`/proc/${pid}/stat`, 'utf8');
+    const rest = stat.slice(stat.lastIndexOf(')') + 2).split(' ');
+    return Number(rest[11]) + Number(rest[12]);
+  } catch {
+    return 0;
+  }
+}
+
+class LoadSampler {
+  // pids: () => external miner pids to count as our own load; without it the
+  // current process (main thread plus worker threads) is counted.
+  // readTicks(pid) defaults to /proc/<pid>/stat.
+  constructor({ pids, readTicks = readPidTicks } = {}) {
+    this.pids = pids;
+    this.readTicks = readTicks;
+    this.cpus = os.cpus().length;
+    this.prev = this._read();
+  }
+
+  // Own time is kept per pid: the miner pids change when an external miner
+  // is restarted with a new thread count.
+  _read() {
+    const cpu = readProcStat() || readCpusTimes();
+    const own = this.pids
+      ? new Map(this.pids().map(pid => [pid, this.readTicks(pid)]))
+      : new Map([[process.pid, (process.cpuUsage().user + process.cpuUsage().system) * USER_HZ / 1e6]]);
+    return { ...cpu, own };
+  }
+
+  // Ticks each pid used since the last sample; a pid that is new since then
+  // started within the interval, so all of its time counts.
+  _ownTicks(cur) {
+    let ticks = 0;
+    for (const [pid, t] of cur.own) ticks += Math.max(0, t - (this.prev.own.get(pid) || 0));
+    return ticks;
+  }
+
+  // { busy, own, foreign } as fractions of the whole machine since the last
+  // sample, foreignCores (cores the rest of the system kept busy) and loadavg1.
+  sample() {
+    const cur = this._read();
+    const dTotal = cur.total - this.prev.total;
+    const busy = dTotal > 0 ? (cur.busy - this.prev.busy) / dTotal : 0;
+    const own = dTotal > 0 ? this._ownTicks(cur) / dTotal : 0;
+    this.prev = cur;
+    const foreign = Math.min(1, Math.max(0, busy - own));
+    return {
+      busy: +busy.toFixed(3),
+      own: +own.toFixed(3),
+      foreign: +foreign.toFixed(3),
+      foreignCores: +(foreign * this.cpus).toFixed(2),
+      loadavg1: readLoadavg(),
+      cpus: this.cpus
+    };
+  }
+}
+
+module.exports = { LoadSampler };
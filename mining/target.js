@@ -0,0 +1,58 @@
+// Compact nBits <-> 256-bit target helpers.
+// Targets are 32-byte big-endian Buffers; digests are raw SHA-256 output
+// (little-endian when read as a number, like Bitcoin).
+const { bswap32 } = require('./sha256');
+
+function bitsToTarget(bits) {
+  const exponent = bits >>> 24;
+  let mantissa = bits & 0x007fffff;
+  const target = Buffer.alloc(32);
+  if (exponent <= 3) {
+    mantissa >>>= 8 * (3 - exponent);
+    target.writeUIntBE(mantissa, 29, 3);
+    return target;
+  }
+  const start = 32 - exponent;
+  for (let i = 0; i < 3; i++) {
+    const pos = start + i;
+    if (pos >= 0 && pos < 32) target[pos] = (mantissa >>> (8 * (2 - i))) & 0xff;
+  }
+  return target;
+}
+
+// True when the raw digest, read as a little-endian number, is <= target.
+function meetsTarget(digest, target) {
+  for (let i = 0; i < 32; i++) {
+    const d = digest[31 - i];
+    const t = target[i];
+    if (d < t) return true;
+    if (d > t) return false;
+  }
+  return true;
+}
+
+// Target as 8 uint32 words, most significant first, for word-wise compares.
+function targetWords(target) {
+  const words = new Uint32Array(8);
+  for (let i = 0; i < 8; i++) words[i] = target.readUInt32BE(i * 4);
+  return words;
+}
+
+// Same test as meetsTarget, on SHA-256 state words instead of digest bytes.
+// state[7] holds the most significant 32 bits (byte-swapped), so callers
+// reject on bswap32(state[7]) > words[0] first and only call this for survivors.
+function meetsTargetWords(state, words) {
+  for (let i = 0; i < 8; i++) {
+    const h = bswap32(state[7 - i]);
+    if (h < words[i]) return true;
+    if (h > words[i]) return false;
+  }
+  return true;
+}
+
+// Display form of a raw digest (byte-reversed hex, as block explorers show it).
+function hashToHex(digest) {
+  return Buffer.from(digest).reverse().toString('hex');
+}
+
+module.exports = { bitsToTarget, meetsTarget, targetWords, meetsTargetWords, hashToHex };
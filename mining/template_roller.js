@@ -0,0 +1,67 @@
+const { sha256d } = require('./sha256');
+const { computeMidstate } = require('./nonce_search');
+const { rootFromBranch } = require('./merkle');
+
+// Hands out successive header templates once a template's 2^32 nonces are used
+// up. nTime is bumped first (only the tail block changes, so the midstate is
+// kept); once the window is spent the extranonce is rolled, which rebuilds the
+// coinbase txid, the merkle root (log2(n) hashes along the cached coinbase
+// branch, see merkle.js) and the midstate but nothing else.
+class TemplateRoller {
+  // header:       base 80-byte header (template 0)
+  // coinbaseFor:  extranonce -> serialized coinbase; omit to roll nTime only
+  // merkleBranch: sibling hashes along the coinbase's path to the root
+  //               (CoinbaseMerkle#branch, or a pool's merkle_branch)
+  // txidFor:      coinbase -> txid for rolled coinbases, e.g. a
+  //               CoinbaseLayout's midstate hasher; defaults to sha256d
+  // timeWindow:   how many seconds nTime may advance per extranonce
+  constructor({ header, coinbaseFor = null, merkleBranch = [], txidFor = sha256d, timeWindow }) {
+    this.base = Buffer.from(header);
+    this.coinbaseFor = coinbaseFor;
+    this.merkleBranch = merkleBranch.map(h => Buffer.from(h));
+    this.txidFor = txidFor;
+    this.timeWindow = timeWindow ?? (coinbaseFor ? 0 : Infinity);
+    this.baseTime = this.base.readUInt32LE(68);
+
+    this.index = 0;
+    this.extranonce = 0;
+    this.timeOffset = 0;
+    this.header = Buffer.from(this.base);
+    this.coinbase = coinbaseFor ? coinbaseFor(0) : null;
+    this.midstate = computeMidstate(this.header);
+  }
+
+  merkleRootFor(coinbase) {
+    return rootFromBranch(this.txidFor(coinbase), this.merkleBranch);
+  }
+
+  current() {
+    return {
+      index: this.index,
+      header: Buffer.from(this.header),
+      midstate: this.midstate,
+      extranonce: this.extranonce,
+      nTime: this.header.readUInt32LE(68),
+      coinbase: this.coinbase
+    };
+  }
+
+  // Advances to the next template and returns it.
+  next() {
+    this.index++;
+    if (this.timeOffset < this.timeWindow || !this.coinbaseFor) {
+      this.timeOffset++;
+      this.header.writeUInt32LE((this.baseTime + this.timeOffset) >>> 0, 68);
+      return this.current();
+    }
+    this.extranonce++;
+    this.timeOffset = 0;
+    this.coinbase = this.coinbaseFor(this.extranonce);
+    this.merkleRootFor(this.coinbase).copy(this.header, 36);
+    this.header.writeUInt32LE(this.baseTime >>> 0, 68);
+    this.midstate = computeMidstate(this.header);
+    return this.current();
+  }
+}
+
+module.exports = { TemplateRoller };
@@ -0,0 +1,56 @@
+// Duty-cycle throttle for the built-in engine. After each compute slice the
+// caller sleeps long enough that compute takes `intensity`% of wall time.
+// Sleep owed is carried as a running balance: sub-millisecond amounts add up
+// until a timer is worth scheduling, and timer overshoot is paid back from the
+// next slice, so the long-run duty cycle stays on target.
+class DutyCycle {
+  constructor(intensity = 100) {
+    this.debt = 0;
+    this.set(intensity);
+  }
+
+  // 0 pauses hashing entirely, 100 never sleeps.
+  set(intensity) {
+    const v = Number(intensity);
+    this.intensity = Number.isFinite(v) ? Math.min(100, Math.max(0, Math.round(v))) : 100;
+    this.debt = 0;
+  }
+
+  get paused() {
+    return this.intensity === 0;
+  }
+
+  // Milliseconds to sleep after a slice that computed for busyMs (0 = yield only).
+  owed(busyMs) {
+    if (this.intensity >= 100 || this.intensity === 0) return 0;
+    this.debt += busyMs * (100 - this.intensity) / this.intensity;
+    return this.debt >= 1 ? Math.floor(this.debt) : 0;
+  }
+
+  // Reports how long the sleep actually lasted.
+  slept(ms) {
+    this.debt -= ms;
+  }
+}
+
+// Runs fn after the sleep owed for a busyMs slice: setImmediate when nothing is
+// owed, otherwise a timer whose real duration is fed back to the duty cycle.
+function afterSlice(duty, busyMs, fn) {
+  const ms = duty.owed(busyMs);
+  if (!ms) return { immediate: setImmediate(fn) };
+  const start = process.hrtime.bigint();
+  return {
+    timer: setTimeout(() => {
+      duty.slept(Number(process.hrtime.bigint() - start) / 1e6);
+      fn();
+    }, ms)
+  };
+}
+
+function cancelSlice(handle) {
+  if (!handle) return;
+  if (handle.immediate) clearImmediate(handle.immediate);
+  if (handle.timer) clearTimeout(handle.timer);
+}
+
+module.exports = { DutyCycle, afterSlice, cancelSlice };
@@ -0,0 +1,167 @@
+// CPU topology and worker placement. On Linux the layout comes from
+// /sys/devices/system/cpu (package, core and NUMA node of each logical CPU);
+// elsewhere every CPU is its own core on node 0.
+//
+// placement(n) lists the CPUs n workers should be pinned to: one thread per
+// physical core before any hyperthread sibling, and workers kept together on
+// a node so a pool smaller than the machine stays on one socket. claim()
+// does the same for one of several pinned miners (built-in pools, external
+// miners), skipping the CPUs the others hold.
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { execFileSync } = require('child_process');
+const native = require('./native');
+
+const SYS_CPU = '/sys/devices/system/cpu';
+
+function readInt(file) {
+  try {
+    return parseInt(fs.readFileSync(file, 'utf8'), 10);
+  } catch {
+    return NaN;
+  }
+}
+
+// "0-3,8,10-11" -> [0, 1, 2, 3, 8, 10, 11]
+function parseCpuList(text) {
+  const out = [];
+  for (const part of String(text).trim().split(',').filter(Boolean)) {
+    const [a, b = a] = part.split('-').map(Number);
+    for (let i = a; i <= b; i++) out.push(i);
+  }
+  return out;
+}
+
+function nodeOf(cpuDir) {
+  try {
+    const link = fs.readdirSync(cpuDir).find(f => /^node\d+$/.test(f));
+    return link ? Number(link.slice(4)) : 0;
+  } catch {
+    return 0;
+  }
+}
+
+// [{ cpu, node, package, core }] for every online logical CPU.
+function readTopology() {
+  let online;
+  try {
+    online = parseCpuList(fs.readFileSync(path.join(SYS_CPU, 'online'), 'utf8'));
+  } catch {
+    return os.cpus().map((_, cpu) => ({ cpu, node: 0, package: 0, core: cpu }));
+  }
+  return online.map(cpu => {
+    const dir = path.join(SYS_CPU, `cpu${cpu}`);
+    const pkg = readInt(path.join(dir, 'topology', 'physical_package_id'));
+    const core = readInt(path.join(dir, 'topology', 'core_id'));
+    return {
+      cpu,
+      node: nodeOf(dir),
+      package: Number.isNaN(pkg) ? 0 : pkg,
+      core: Number.isNaN(core) ? cpu : core
+    };
+  });
+}
+
+let cached = null;
+function topology() {
+  if (!cached) cached = readTopology();
+  return cached;
+}
+
+// CPUs in pinning order: node, then sibling rank (first thread of every core
+// on the node before any second thread), then package and core.
+function cpuOrder(cpus = topology()) {
+  const rank = new Map();
+  const seen = new Map();
+  for (const c of [...cpus].sort((a, b) => a.cpu - b.cpu)) {
+    const key = `${c.package}:${c.core}`;
+    const n = seen.get(key) || 0;
+    seen.set(key, n + 1);
+    rank.set(c.cpu, n);
+  }
+  return [...cpus].sort((a, b) =>
+    a.node - b.node || rank.get(a.cpu) - rank.get(b.cpu) ||
+    a.package - b.package || a.core - b.core || a.cpu - b.cpu);
+}
+
+// [{ worker, cpu, node }] for n workers; wraps around when n exceeds the CPUs.
+// CPUs in `taken` are used only once every other one is.
+function placement(n, cpus = topology(), taken = new Set()) {
+  const all = cpuOrder(cpus);
+  const order = [...all.filter(c => !taken.has(c.cpu)), ...all.filter(c => taken.has(c.cpu))];
+  return Array.from({ length: n }, (_, worker) => {
+    const c = order[worker % order.length];
+    return { worker, cpu: c.cpu, node: c.node };
+  });
+}
+
+// CPUs held by running pinned miners, by owner.
+const claims = new Map();
+
+// placement() for `owner`, around the CPUs other owners hold; replaces the
+// owner's earlier claim. Give it back with release().
+function claim(owner, n, cpus = topology()) {
+  const taken = new Set();
+  for (const [other, held] of claims) if (other !== owner) held.forEach(cpu => taken.add(cpu));
+  const plan = placement(n, cpus, taken);
+  claims.set(owner, plan.map(p => p.cpu));
+  return plan;
+}
+
+function release(owner) {
+  claims.delete(owner);
+}
+
+// Counts for diagnostics.
+function summary(cpus = topology()) {
+  const count = key => new Set(cpus.map(key)).size;
+  return {
+    nodes: count(c => c.node),
+    packages: count(c => c.package),
+    cores: count(c => `${c.package}:${c.core}`),
+    threads: cpus.length
+  };
+}
+
+// Pins the calling thread (a worker thread when called from one) to `cpu`.
+// Uses the native addon, or taskset on the thread id from /proc/thread-self.
+function pinCurrentThread(cpu) {
+  if (native.available && native.addon.pinThread) return native.addon.pinThread(cpu);
+  if (process.platform !== 'linux') return false;
+  try {
+    const tid = fs.readlinkSync('/proc/thread-self').split('/').pop();
+    execFileSync('taskset', ['-p', '-c', String(cpu), tid], { stdio: 'ignore' });
+    return true;
+  } catch {
+    return false;
+  }
+}
+
+function currentCpu() {
+  return native.available && native.addon.currentCpu ? native.addon.currentCpu() : -1;
+}
+
+// Wraps an external miner command in `taskset -c <cpus>` where available.
+function tasksetCommand(exePath, args, cpus) {
+  if (process.platform !== 'linux' || !cpus.length) return null;
+  try {
+    execFileSync('taskset', ['-V'], { stdio: 'ignore' });
+  } catch {
+    return null;
+  }
+  return { command: 'taskset', args: ['-c', cpus.join(','), exePath, ...args] };
+}
+
+module.exports = {
+  parseCpuList,
+  readTopology,
+  topology,
+  placement,
+  claim,
+  release,
+  summary,
+  pinCurrentThread,
+  currentCpu,
+  tasksetCommand
+};
@@ -0,0 +1,248 @@
+const os = require('os');
+const path = require('path');
+const { Worker } = require('worker_threads');
+const { TemplateRoller } = require('./template_roller');
+const { NonceScheduler } = require('./scheduler');
+const pow = require('./pow');
+const topology = require('./topology');
+const { SharedStats } = require('./shared_stats');
+const { JobEpoch } = require('./job_epoch');
+const { SeededScheduler } = require('./seeded_scheduler');
+
+const WORKER_FILE = path.join(__dirname, 'miner_worker.js');
+// Non-clean job switches whose shares are still passed on.
+const RETIRED_JOBS = 4;
+
+function defaultThreads() {
+  return Math.max(1, os.cpus().length);
+}
+
+// Pool of worker_threads. Workers pull adaptive nonce chunks from a
+// work-stealing NonceScheduler before their current chunk is finished. The
+// main thread only schedules, rolls templates and aggregates reports.
+// Progress is not messaged: workers count into SharedStats slots that the
+// main thread reads when it builds stats.
+//
+// With affinity set, worker i is pinned to the i-th CPU of a topology.claim()
+// (physical cores first, grouped by NUMA node, away from CPUs other pinned
+// miners hold); workers report where they ended up.
+class WorkerPool {
+  constructor({ threads, intensity = 100, affinity = false } = {}) {
+    this.size = Math.max(1, Number(threads) || defaultThreads());
+    this.intensity = intensity;
+    this.active = this.size;
+    this.workers = [];
+    this.stats = new SharedStats(this.size);
+    this.drained = 0;
+    this.jobEpoch = new JobEpoch();
+    this.epoch = 0;
+    // Jobs replaced without a clean switch, by epoch: their shares still count.
+    this.retired = new Map();
+    this.tag = null;
+    this.switches = 0;
+    this.plan = affinity ? topology.claim(this, this.size) : null;
+    this.placements = new Array(this.size).fill(null);
+  }
+
+  // job: { header, target, algorithm, nonceStart, roller, resume, seed, chunk }.
+  // Without a roller only nTime is rolled. A seed switches to the deterministic
+  // SeededScheduler (fixed chunks of `chunk` nonces in seeded order); a
+  // prebuilt `scheduler` (e.g. MultiScheduler) replaces header/roller entirely.
+  // onChunkDone(worker, template, start, end) fires for every fully hashed chunk.
+  // onError(worker, err) fires when a worker throws or exits before stop().
+  // job.tag is handed back with the job's shares (e.g. the pool job they belong to).
+  start(job, { onFound, onChunkDone, onError } = {}) {
+    this._newJob(job);
+    this.tag = job.tag ?? null;
+
+    for (let i = 0; i < this.size; i++) {
+      const plan = this.plan && this.plan[i];
+      const worker = new Worker(WORKER_FILE, {
+        workerData: {
+          index: i,
+          intensity: this.intensity,
+          slots: this.size,
+          stats: this.stats.buffer,
+          epoch: this.jobEpoch.buffer,
+          cpu: plan ? plan.cpu : null,
+          node: plan ? plan.node : null
+        }
+      });
+      worker.on('message', (msg) => {
+        if (msg.type === 'placement') {
+          this.placements[msg.worker] = { cpu: msg.cpu, node: msg.node, pinned: msg.pinned, runningOn: msg.runningOn };
+        } else if (msg.type === 'need-work') {
+          // Asked before a job switch; the switch already sent fresh work.
+          if (msg.epoch !== this.epoch) return;
+          const last = msg.last;
+          if (last) {
+            this.scheduler.record(msg.worker, last.hashes, last.ms, last.template);
+            onChunkDone && onChunkDone(msg.worker, last.template, last.start, last.end);
+          }
+          const unit = this._nextUnit(msg.worker);
+          if (unit) worker.postMessage(unit);
+        } else if (msg.type === 'found') {
+          // A share from a job replaced by a clean switch is passed on as
+          // stale, without its template.
+          const job = msg.epoch === this.epoch ? this : this.retired.get(msg.epoch);
+          onFound && onFound({
+            worker: msg.worker,
+            nonce: msg.nonce,
+            hash: msg.hash,
+            header: Buffer.from(msg.header),
+            template: job ? job.scheduler.templates.get(msg.template) : null,
+            tag: job ? job.tag : null,
+            stale: !job
+          });
+        }
+      });
+      worker.on('error', (err) => {
+        console.error(`miner worker ${i} failed:`, err);
+        onError && onError(i, err);
+      });
+      // Workers are dropped from this.workers on stop(); any other exit is a failure.
+      worker.on('exit', (code) => {
+        if (this.workers.includes(worker)) onError && onError(i, new Error(`miner worker ${i} exited with code ${code}`));
+      });
+      this.workers.push(worker);
+      this._postJob(i);
+    }
+  }
+
+  _newJob({ header, target = null, algorithm = 'sha256d', nonceStart = 0, roller, resume, seed, chunk, scheduler }) {
+    const prev = this.algorithm === algorithm ? this.scheduler : null;
+    this.target = target;
+    this.algorithm = algorithm;
+    if (scheduler) {
+      this.scheduler = scheduler;
+    } else {
+      roller = roller || new TemplateRoller({ header });
+      this.scheduler = seed !== undefined && seed !== null
+        ? new SeededScheduler({ workers: this.size, roller, seed, chunk })
+        : new NonceScheduler({ workers: this.size, roller, nonceStart, cost: pow.get(algorithm).cost.relative, resume });
+      if (prev) this.scheduler.adopt(prev);
+    }
+    // Templates of the chunk each worker is hashing and the one queued behind it.
+    this.live = Array.from({ length: this.size }, () => []);
+  }
+
+  _postJob(i) {
+    const w = this.workers[i];
+    w.postMessage({ type: 'job', target: this.target, algorithm: this.algorithm, epoch: this.epoch });
+    const unit = this._nextUnit(i);
+    if (unit) w.postMessage(unit);
+  }
+
+  // Replaces the job on every worker. The epoch bump makes workers drop the
+  // old template between sub-batches, mid-slice; the 'job' and 'work'
+  // messages then carry the new one. job: { header, target, algorithm,
+  // nonceStart, roller, clean, tag }; target and algorithm default to the
+  // current job's. clean (new block, or a pool's clean_jobs) makes shares of
+  // every earlier job stale; otherwise the last few jobs' shares still
+  // arrive with their template and tag.
+  switchJob({ header, target = this.target, algorithm = this.algorithm, nonceStart = 0, roller, seed, chunk, clean = true, tag = null }) {
+    if (clean) {
+      this.retired.clear();
+    } else {
+      this.retired.set(this.epoch, { scheduler: this.scheduler, tag: this.tag });
+      if (this.retired.size > RETIRED_JOBS) this.retired.delete(this.retired.keys().next().value);
+    }
+    this.tag = tag;
+    this.epoch = this.jobEpoch.bump();
+    this.switches++;
+    this._newJob({ header, target, algorithm, nonceStart, roller, seed, chunk });
+    for (let i = 0; i < this.workers.length; i++) this._postJob(i);
+  }
+
+  // Next work message for worker i, or null once the scheduler has nothing left.
+  // Templates that carry their own target/algorithm (MultiScheduler) pass them on.
+  _nextUnit(i) {
+    const unit = this.scheduler.next(i);
+    if (!unit) return null;
+    const { template: t, start, end } = unit;
+    const live = this.live[i];
+    live.push(t.index);
+    if (live.length > 2) live.shift();
+    this.scheduler.prune(this.live.flat());
+    return {
+      type: 'work',
+      epoch: this.epoch,
+      template: t.index,
+      header: t.header,
+      midstate: t.midstate,
+      target: t.target,
+      algorithm: t.algorithm,
+      start,
+      end
+    };
+  }
+
+  // Changes every worker's duty cycle (0-100%) without interrupting the search.
+  setIntensity(intensity) {
+    this.intensity = intensity;
+    for (const w of this.workers) w.postMessage({ type: 'intensity', value: intensity });
+  }
+
+  // Parks workers n and above (the idle-aware scheduler's knob). A parked
+  // worker keeps its in-flight chunk and finishes it when it is reactivated.
+  setActive(n) {
+    this.active = Math.min(this.size, Math.max(0, n));
+    this.workers.forEach((w, i) => w.postMessage({ type: 'active', value: i < this.active }));
+  }
+
+  cursor() {
+    return this.scheduler.cursor();
+  }
+
+  // Per-worker throughput, chunk and slice sizing, for spotting imbalance.
+  workerStats() {
+    if (!this.scheduler) return [];
+    return this.scheduler.workerStats().map((w, i) => ({
+      ...w,
+      batch: this.stats.read(i).batch,
+      active: i < this.active,
+      cpu: this.placements[i] ? this.placements[i].cpu : null
+    }));
+  }
+
+  // Where each worker runs: { worker, cpu, node, pinned, runningOn } (cpu and
+  // node are null when affinity is off).
+  placement() {
+    return this.placements.map((p, worker) => ({ worker, ...(p || { cpu: null, node: null, pinned: false, runningOn: -1 }) }));
+  }
+
+  // Mean hashes per worker slice (each worker sizes its own).
+  batchSize() {
+    const known = [];
+    for (let i = 0; i < this.size; i++) {
+      const b = this.stats.read(i).batch;
+      if (b) known.push(b);
+    }
+    return known.length ? Math.round(known.reduce((a, b) => a + b, 0) / known.length) : 0;
+  }
+
+  // { hashes, shares, bestDifficulty, wastedHashes, switchMs } over all
+  // workers since start, plus the number of job switches.
+  totals() {
+    return { ...this.stats.total(), switches: this.switches };
+  }
+
+  // Hashes done since the last call.
+  drainHashes() {
+    const total = this.stats.total().hashes;
+    const n = total - this.drained;
+    this.drained = total;
+    return n;
+  }
+
+  stop() {
+    for (const w of this.workers) {
+      w.postMessage({ type: 'stop' });
+      setTimeout(() => w.terminate(), 1000).unref();
+    }
+    this.workers = [];
+    if (this.plan) topology.release(this);
+  }
+}
+
+module.exports = { WorkerPool, defaultThreads };
@@ -0,0 +1,23 @@
+{
+  "targets": [
+    {
+      "target_name": "soulvan_hash",
+      "sources": [
+        "src/addon.cc",
+        "src/cpu_features.cc",
+        "src/sha256_scalar.cc",
+        "src/sha256_shani.cc",
+        "src/sha256_avx2.cc",
+        "src/ripemd160.cc",
+        "src/affinity.cc"
+      ],
+      "cflags_cc": ["-O3", "-std=c++17"],
+      "xcode_settings": {
+        "OTHER_CPLUSPLUSFLAGS": ["-O3", "-std=c++17"]
+      },
+      "msvs_settings": {
+        "VCCLCompilerTool": { "Optimization": 2, "AdditionalOptions": ["/std:c++17"] }
+      }
+    }
+  ]
+}
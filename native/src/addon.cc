@@ -0,0 +1,261 @@
+// N-API entry points for the optional native hashing kernel.
+//
+//   scanRange(midstate, tail, target, start, count[, maxResults[, impl]]) -> number[]
+//     at most min(maxResults, count, 4096) winning nonces
+//     midstate: 32-byte SHA-256 state after header bytes 0..63 (big-endian words)
+//     tail:     header bytes 64..79
+//   hashMany(algorithm, input, stride, count[, impl]) -> Buffer
+//     algorithm: 'sha256' | 'sha256d' | 'ripemd160'
+//     input:     count messages of stride bytes each, back to back
+//     returns the digests back to back (32 bytes each, 20 for ripemd160)
+//   cpuFeatures() -> { sse41, sha, avx2, impl }
+//   pinThread(cpu) -> boolean    pins the calling (worker) thread to one CPU
+//   currentCpu() -> number       CPU the calling thread runs on, -1 if unknown
+#include <node_api.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "sha256d.h"
+
+namespace soulvan {
+namespace {
+
+struct Kernel {
+  const char* name;
+  ScanFn fn;
+  HashManyFn many;
+};
+
+const CpuFeatures& Cpu() {
+  static const CpuFeatures cpu = DetectCpu();
+  return cpu;
+}
+
+// Best kernel this CPU can run: SHA-NI, then 8-way AVX2, then scalar.
+Kernel BestKernel() {
+#ifdef SOULVAN_X86
+  if (Cpu().sha) return {"sha-ni", ScanShaNi, Sha256ManyShaNi};
+  if (Cpu().avx2) return {"avx2", ScanAvx2, Sha256ManyAvx2};
+#endif
+  return {"scalar", ScanScalar, Sha256ManyScalar};
+}
+
+bool KernelByName(const std::string& name, Kernel* out) {
+  if (name == "scalar") { *out = {"scalar", ScanScalar, Sha256ManyScalar}; return true; }
+#ifdef SOULVAN_X86
+  if (name == "sha-ni" && Cpu().sha) { *out = {"sha-ni", ScanShaNi, Sha256ManyShaNi}; return true; }
+  if (name == "avx2" && Cpu().avx2) { *out = {"avx2", ScanAvx2, Sha256ManyAvx2}; return true; }
+#endif
+  return false;
+}
+
+#define NAPI_CALL(env, call)                                   \
+  do {                                                         \
+    if ((call) != napi_ok) {                                   \
+      napi_throw_error(env, nullptr, "N-API call failed: " #call); \
+      return nullptr;                                          \
+    }                                                          \
+  } while (0)
+
+bool GetBuffer(napi_env env, napi_value v, size_t want, const uint8_t** data) {
+  bool is_buf = false;
+  if (napi_is_buffer(env, v, &is_buf) != napi_ok || !is_buf) return false;
+  void* ptr = nullptr;
+  size_t len = 0;
+  if (napi_get_buffer_info(env, v, &ptr, &len) != napi_ok || len != want) return false;
+  *data = static_cast<const uint8_t*>(ptr);
+  return true;
+}
+
+// Optional impl argument; leaves *kernel untouched unless it is a string.
+// Returns false (with an exception pending) for an unknown or unsupported name.
+bool GetKernel(napi_env env, napi_value v, Kernel* kernel) {
+  napi_valuetype t;
+  if (napi_typeof(env, v, &t) != napi_ok) return false;
+  if (t != napi_string) return true;
+  char name[16] = {0};
+  size_t len = 0;
+  if (napi_get_value_string_utf8(env, v, name, sizeof(name), &len) != napi_ok) return false;
+  if (!KernelByName(name, kernel)) {
+    napi_throw_error(env, nullptr, "requested kernel is not available on this CPU");
+    return false;
+  }
+  return true;
+}
+
+// Upper bound on scanRange's maxResults.
+constexpr uint32_t kMaxScanResults = 4096;
+
+napi_value ScanRange(napi_env env, napi_callback_info info) {
+  size_t argc = 7;
+  napi_value argv[7];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  if (argc < 5) {
+    napi_throw_type_error(env, nullptr, "scanRange(midstate, tail, target, start, count[, maxResults[, impl]])");
+    return nullptr;
+  }
+
+  const uint8_t* mid_bytes = nullptr;
+  const uint8_t* tail = nullptr;
+  const uint8_t* target = nullptr;
+  if (!GetBuffer(env, argv[0], 32, &mid_bytes)) {
+    napi_throw_type_error(env, nullptr, "midstate must be a 32-byte Buffer");
+    return nullptr;
+  }
+  if (!GetBuffer(env, argv[1], 16, &tail)) {
+    napi_throw_type_error(env, nullptr, "tail must be a 16-byte Buffer");
+    return nullptr;
+  }
+  if (!GetBuffer(env, argv[2], 32, &target)) {
+    napi_throw_type_error(env, nullptr, "target must be a 32-byte Buffer");
+    return nullptr;
+  }
+  uint32_t midstate[8];
+  for (int i = 0; i < 8; i++) midstate[i] = LoadBe32(mid_bytes + i * 4);
+
+  uint32_t start = 0;
+  double count_d = 0;
+  uint32_t max_out = 1;
+  NAPI_CALL(env, napi_get_value_uint32(env, argv[3], &start));
+  NAPI_CALL(env, napi_get_value_double(env, argv[4], &count_d));
+  if (argc > 5) NAPI_CALL(env, napi_get_value_uint32(env, argv[5], &max_out));
+  if (count_d < 0 || count_d > 4294967296.0) {
+    napi_throw_range_error(env, nullptr, "count must be within [0, 2^32]");
+    return nullptr;
+  }
+  // The winners buffer is sized from maxResults, so it is capped: no more
+  // than one per nonce, and never more than kMaxScanResults.
+  if (count_d < max_out) max_out = static_cast<uint32_t>(count_d);
+  if (max_out > kMaxScanResults) max_out = kMaxScanResults;
+  if (max_out == 0) max_out = 1;
+
+  Kernel kernel = BestKernel();
+  if (argc > 6 && !GetKernel(env, argv[6], &kernel)) return nullptr;
+
+  std::vector<uint32_t> winners(max_out);
+  uint64_t hashes = 0;
+  const uint32_t n = kernel.fn(midstate, tail, target, start, uint64_t(count_d), winners.data(), max_out, &hashes);
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_array_with_length(env, n, &result));
+  for (uint32_t i = 0; i < n; i++) {
+    napi_value v;
+    NAPI_CALL(env, napi_create_uint32(env, winners[i], &v));
+    NAPI_CALL(env, napi_set_element(env, result, i, v));
+  }
+  return result;
+}
+
+napi_value HashMany(napi_env env, napi_callback_info info) {
+  size_t argc = 5;
+  napi_value argv[5];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  if (argc < 4) {
+    napi_throw_type_error(env, nullptr, "hashMany(algorithm, input, stride, count[, impl])");
+    return nullptr;
+  }
+
+  char algo[16] = {0};
+  size_t algo_len = 0;
+  NAPI_CALL(env, napi_get_value_string_utf8(env, argv[0], algo, sizeof(algo), &algo_len));
+  const std::string algorithm(algo, algo_len);
+  const bool ripemd = algorithm == "ripemd160";
+  if (!ripemd && algorithm != "sha256" && algorithm != "sha256d") {
+    napi_throw_error(env, nullptr, "unsupported algorithm");
+    return nullptr;
+  }
+
+  bool is_buf = false;
+  NAPI_CALL(env, napi_is_buffer(env, argv[1], &is_buf));
+  if (!is_buf) {
+    napi_throw_type_error(env, nullptr, "input must be a Buffer");
+    return nullptr;
+  }
+  void* in = nullptr;
+  size_t in_len = 0;
+  NAPI_CALL(env, napi_get_buffer_info(env, argv[1], &in, &in_len));
+
+  uint32_t stride = 0;
+  uint32_t count = 0;
+  NAPI_CALL(env, napi_get_value_uint32(env, argv[2], &stride));
+  NAPI_CALL(env, napi_get_value_uint32(env, argv[3], &count));
+  if (uint64_t(stride) * count > in_len) {
+    napi_throw_range_error(env, nullptr, "stride * count exceeds the input length");
+    return nullptr;
+  }
+
+  Kernel kernel = BestKernel();
+  if (argc > 4 && !GetKernel(env, argv[4], &kernel)) return nullptr;
+
+  const size_t digest = ripemd ? 20 : 32;
+  void* out = nullptr;
+  napi_value result;
+  NAPI_CALL(env, napi_create_buffer(env, digest * count, &out, &result));
+  const uint8_t* src = static_cast<const uint8_t*>(in);
+  uint8_t* dst = static_cast<uint8_t*>(out);
+  if (ripemd) {
+    Ripemd160Many(src, stride, count, dst);
+  } else {
+    kernel.many(src, stride, count, algorithm == "sha256d", dst);
+  }
+  return result;
+}
+
+napi_value SetBool(napi_env env, napi_value obj, const char* key, bool value) {
+  napi_value v;
+  if (napi_get_boolean(env, value, &v) != napi_ok) return nullptr;
+  if (napi_set_named_property(env, obj, key, v) != napi_ok) return nullptr;
+  return obj;
+}
+
+napi_value CpuFeaturesJs(napi_env env, napi_callback_info) {
+  napi_value obj;
+  NAPI_CALL(env, napi_create_object(env, &obj));
+  SetBool(env, obj, "sse41", Cpu().sse41);
+  SetBool(env, obj, "sha", Cpu().sha);
+  SetBool(env, obj, "avx2", Cpu().avx2);
+  napi_value impl;
+  const char* name = BestKernel().name;
+  NAPI_CALL(env, napi_create_string_utf8(env, name, std::strlen(name), &impl));
+  NAPI_CALL(env, napi_set_named_property(env, obj, "impl", impl));
+  return obj;
+}
+
+napi_value PinThreadJs(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  int32_t cpu = -1;
+  if (argc < 1 || napi_get_value_int32(env, argv[0], &cpu) != napi_ok) {
+    napi_throw_type_error(env, nullptr, "pinThread(cpu)");
+    return nullptr;
+  }
+  napi_value result;
+  NAPI_CALL(env, napi_get_boolean(env, PinThread(cpu), &result));
+  return result;
+}
+
+napi_value CurrentCpuJs(napi_env env, napi_callback_info) {
+  napi_value result;
+  NAPI_CALL(env, napi_create_int32(env, CurrentCpu(), &result));
+  return result;
+}
+
+napi_value Init(napi_env env, napi_value exports) {
+  napi_property_descriptor props[] = {
+    {"scanRange", nullptr, ScanRange, nullptr, nullptr, nullptr, napi_default, nullptr},
+    {"hashMany", nullptr, HashMany, nullptr, nullptr, nullptr, napi_default, nullptr},
+    {"cpuFeatures", nullptr, CpuFeaturesJs, nullptr, nullptr, nullptr, napi_default, nullptr},
+    {"pinThread", nullptr, PinThreadJs, nullptr, nullptr, nullptr, napi_default, nullptr},
+    {"currentCpu", nullptr, CurrentCpuJs, nullptr, nullptr, nullptr, napi_default, nullptr},
+  };
+  NAPI_CALL(env, napi_define_properties(env, exports, sizeof(props) / sizeof(props[0]), props));
+  return exports;
+}
+
+}  // namespace
+}  // namespace soulvan
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, soulvan::Init)
@@ -0,0 +1,41 @@
+// Thread placement for the mining workers. Each worker_threads worker calls
+// PinThread from its own thread, so only that thread is pinned.
+#include "sha256d.h"
+
+#if defined(__linux__)
+#include <sched.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+namespace soulvan {
+
+bool PinThread(int cpu) {
+  if (cpu < 0) return false;
+#if defined(__linux__)
+  if (cpu >= CPU_SETSIZE) return false;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  // pid 0 is the calling thread, not the whole process.
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+  if (cpu >= int(sizeof(DWORD_PTR) * 8)) return false;
+  return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) != 0;
+#else
+  // macOS only offers affinity hints (thread_policy_set), not pinning.
+  return false;
+#endif
+}
+
+int CurrentCpu() {
+#if defined(__linux__)
+  return sched_getcpu();
+#elif defined(_WIN32)
+  return int(GetCurrentProcessorNumber());
+#else
+  return -1;
+#endif
+}
+
+}  // namespace soulvan
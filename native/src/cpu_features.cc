@@ -0,0 +1,60 @@
+#include "sha256d.h"
+
+#if defined(SOULVAN_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace soulvan {
+
+#if defined(SOULVAN_X86)
+static void Cpuid(uint32_t leaf, uint32_t sub, uint32_t regs[4]) {
+#if defined(_MSC_VER)
+  int r[4];
+  __cpuidex(r, int(leaf), int(sub));
+  for (int i = 0; i < 4; i++) regs[i] = uint32_t(r[i]);
+#else
+  __cpuid_count(leaf, sub, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+static uint64_t Xgetbv0() {
+#if defined(_MSC_VER)
+  return _xgetbv(0);
+#else
+  uint32_t lo, hi;
+  __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+  return (uint64_t(hi) << 32) | lo;
+#endif
+}
+#endif
+
+CpuFeatures DetectCpu() {
+  CpuFeatures f;
+#if defined(SOULVAN_X86)
+  uint32_t r[4];
+  Cpuid(0, 0, r);
+  const uint32_t max_leaf = r[0];
+  if (max_leaf < 1) return f;
+
+  Cpuid(1, 0, r);
+  const bool ssse3 = (r[2] >> 9) & 1;
+  f.sse41 = ssse3 && ((r[2] >> 19) & 1);
+  const bool osxsave = (r[2] >> 27) & 1;
+  const bool avx = (r[2] >> 28) & 1;
+  // AVX state must be enabled by the OS (XCR0 bits 1 and 2).
+  const bool ymm_os = osxsave && avx && ((Xgetbv0() & 0x6) == 0x6);
+
+  if (max_leaf >= 7) {
+    Cpuid(7, 0, r);
+    f.avx2 = ymm_os && ((r[1] >> 5) & 1);
+    f.sha = f.sse41 && ((r[1] >> 29) & 1);
+  }
+#endif
+  return f;
+}
+
+}  // namespace soulvan
@@ -0,0 +1,111 @@
+// Portable RIPEMD-160 for batch address derivation (hashMany('ripemd160', ...)).
+#include "sha256d.h"
+
+namespace soulvan {
+
+namespace {
+
+const uint8_t kR[80] = {
+  0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+  7, 4, 13, 1, 10, 6, 15, 3, 12, 0, 9, 5, 2, 14, 11, 8,
+  3, 10, 14, 4, 9, 15, 8, 1, 2, 7, 0, 6, 13, 11, 5, 12,
+  1, 9, 11, 10, 0, 8, 12, 4, 13, 3, 7, 15, 14, 5, 6, 2,
+  4, 0, 5, 9, 7, 12, 2, 10, 14, 1, 3, 8, 11, 6, 15, 13
+};
+
+const uint8_t kRp[80] = {
+  5, 14, 7, 0, 9, 2, 11, 4, 13, 6, 15, 8, 1, 10, 3, 12,
+  6, 11, 3, 7, 0, 13, 5, 10, 14, 15, 8, 12, 4, 9, 1, 2,
+  15, 5, 1, 3, 7, 14, 6, 9, 11, 8, 12, 2, 10, 0, 4, 13,
+  8, 6, 4, 1, 3, 11, 15, 0, 5, 12, 2, 13, 9, 7, 10, 14,
+  12, 15, 10, 4, 1, 5, 8, 7, 6, 2, 13, 14, 0, 3, 9, 11
+};
+
+const uint8_t kS[80] = {
+  11, 14, 15, 12, 5, 8, 7, 9, 11, 13, 14, 15, 6, 7, 9, 8,
+  7, 6, 8, 13, 11, 9, 7, 15, 7, 12, 15, 9, 11, 7, 13, 12,
+  11, 13, 6, 7, 14, 9, 13, 15, 14, 8, 13, 6, 5, 12, 7, 5,
+  11, 12, 14, 15, 14, 15, 9, 8, 9, 14, 5, 6, 8, 6, 5, 12,
+  9, 15, 5, 11, 6, 8, 13, 12, 5, 12, 13, 14, 11, 8, 5, 6
+};
+
+const uint8_t kSp[80] = {
+  8, 9, 9, 11, 13, 15, 15, 5, 7, 7, 8, 11, 14, 14, 12, 6,
+  9, 13, 15, 7, 12, 8, 9, 11, 7, 7, 12, 7, 6, 15, 13, 11,
+  9, 7, 15, 11, 8, 6, 6, 14, 12, 13, 5, 14, 13, 13, 7, 5,
+  15, 5, 8, 11, 14, 14, 6, 14, 6, 9, 12, 9, 12, 5, 15, 8,
+  8, 5, 12, 9, 12, 5, 14, 6, 8, 13, 6, 5, 15, 13, 11, 11
+};
+
+const uint32_t kK[5] = {0x00000000, 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xa953fd4e};
+const uint32_t kKp[5] = {0x50a28be6, 0x5c4dd124, 0x6d703ef3, 0x7a6d76e9, 0x00000000};
+
+inline uint32_t Rotl(uint32_t x, int n) { return (x << n) | (x >> (32 - n)); }
+
+inline uint32_t F(int round, uint32_t x, uint32_t y, uint32_t z) {
+  switch (round) {
+    case 0: return x ^ y ^ z;
+    case 1: return (x & y) | (~x & z);
+    case 2: return (x | ~y) ^ z;
+    case 3: return (x & z) | (y & ~z);
+    default: return x ^ (y | ~z);
+  }
+}
+
+inline uint32_t LoadLe32(const uint8_t* p) {
+  return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+void Compress(uint32_t h[5], const uint32_t x[16]) {
+  uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+  uint32_t ap = a, bp = b, cp = c, dp = d, ep = e;
+  for (int j = 0; j < 80; j++) {
+    const int round = j / 16;
+    uint32_t t = Rotl(a + F(round, b, c, d) + x[kR[j]] + kK[round], kS[j]) + e;
+    a = e; e = d; d = Rotl(c, 10); c = b; b = t;
+    t = Rotl(ap + F(4 - round, bp, cp, dp) + x[kRp[j]] + kKp[round], kSp[j]) + ep;
+    ap = ep; ep = dp; dp = Rotl(cp, 10); cp = bp; bp = t;
+  }
+  const uint32_t t = h[1] + c + dp;
+  h[1] = h[2] + d + ep;
+  h[2] = h[3] + e + ap;
+  h[3] = h[4] + a + bp;
+  h[4] = h[0] + b + cp;
+  h[0] = t;
+}
+
+// Same padding as SHA-256 except that words and the bit length are little-endian.
+void Ripemd160One(const uint8_t* msg, size_t len, uint8_t out[20]) {
+  uint32_t h[5] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+  uint32_t x[16];
+  const size_t blocks = PaddedBlocks(len);
+  for (size_t b = 0; b < blocks; b++) {
+    const size_t off = b * 64;
+    if (off + 64 <= len) {
+      for (int i = 0; i < 16; i++) x[i] = LoadLe32(msg + off + i * 4);
+    } else {
+      uint8_t buf[64];
+      for (size_t j = 0; j < 64; j++) {
+        const size_t p = off + j;
+        buf[j] = p < len ? msg[p] : p == len ? 0x80 : 0;
+      }
+      if (b == blocks - 1) {
+        const uint64_t bits = uint64_t(len) * 8;
+        for (int j = 0; j < 8; j++) buf[56 + j] = uint8_t(bits >> (8 * j));
+      }
+      for (int i = 0; i < 16; i++) x[i] = LoadLe32(buf + i * 4);
+    }
+    Compress(h, x);
+  }
+  for (int k = 0; k < 5; k++) {
+    for (int j = 0; j < 4; j++) out[k * 4 + j] = uint8_t(h[k] >> (8 * j));
+  }
+}
+
+}  // namespace
+
+void Ripemd160Many(const uint8_t* in, size_t stride, size_t count, uint8_t* out) {
+  for (size_t i = 0; i < count; i++) Ripemd160One(in + i * stride, stride, out + i * 20);
+}
+
+}  // namespace soulvan
@@ -0,0 +1,153 @@
+// 8-way AVX2 multi-buffer kernels: each 32-bit lane hashes a different nonce
+// (ScanAvx2) or a different packed input (Sha256ManyAvx2).
+#include "sha256d.h"
+
+#ifdef SOULVAN_X86
+
+#include <immintrin.h>
+
+namespace soulvan {
+
+#define V8_ROTR(x, n) _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+
+SOULVAN_TARGET("avx2")
+static inline void Compress8(__m256i s[8], const __m256i block[16]) {
+  __m256i w[64];
+  for (int i = 0; i < 16; i++) w[i] = block[i];
+  for (int i = 16; i < 64; i++) {
+    const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(V8_ROTR(w[i - 15], 7), V8_ROTR(w[i - 15], 18)),
+                                        _mm256_srli_epi32(w[i - 15], 3));
+    const __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(V8_ROTR(w[i - 2], 17), V8_ROTR(w[i - 2], 19)),
+                                        _mm256_srli_epi32(w[i - 2], 10));
+    w[i] = _mm256_add_epi32(_mm256_add_epi32(w[i - 16], s0), _mm256_add_epi32(w[i - 7], s1));
+  }
+
+  __m256i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+  for (int i = 0; i < 64; i++) {
+    const __m256i S1 = _mm256_xor_si256(_mm256_xor_si256(V8_ROTR(e, 6), V8_ROTR(e, 11)), V8_ROTR(e, 25));
+    const __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+    const __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, S1),
+                                        _mm256_add_epi32(_mm256_add_epi32(ch, _mm256_set1_epi32(int(kSha256K[i]))), w[i]));
+    const __m256i S0 = _mm256_xor_si256(_mm256_xor_si256(V8_ROTR(a, 2), V8_ROTR(a, 13)), V8_ROTR(a, 22));
+    const __m256i maj = _mm256_xor_si256(_mm256_xor_si256(_mm256_and_si256(a, b), _mm256_and_si256(a, c)),
+                                         _mm256_and_si256(b, c));
+    const __m256i t2 = _mm256_add_epi32(S0, maj);
+    h = g; g = f; f = e; e = _mm256_add_epi32(d, t1);
+    d = c; c = b; b = a; a = _mm256_add_epi32(t1, t2);
+  }
+  s[0] = _mm256_add_epi32(s[0], a); s[1] = _mm256_add_epi32(s[1], b);
+  s[2] = _mm256_add_epi32(s[2], c); s[3] = _mm256_add_epi32(s[3], d);
+  s[4] = _mm256_add_epi32(s[4], e); s[5] = _mm256_add_epi32(s[5], f);
+  s[6] = _mm256_add_epi32(s[6], g); s[7] = _mm256_add_epi32(s[7], h);
+}
+
+#undef V8_ROTR
+
+SOULVAN_TARGET("avx2")
+uint32_t ScanAvx2(const uint32_t midstate[8], const uint8_t tail[16], const uint8_t target[32],
+                  uint32_t start, uint64_t count,
+                  uint32_t* out, uint32_t max_out, uint64_t* hashes) {
+  uint32_t block2[16];
+  LoadTailBlock(tail, block2);
+
+  __m256i mid[8], b2[16], b3[16], s[8];
+  for (int k = 0; k < 8; k++) mid[k] = _mm256_set1_epi32(int(midstate[k]));
+  for (int k = 0; k < 16; k++) b2[k] = _mm256_set1_epi32(int(block2[k]));
+  uint32_t pad[16];
+  InitDigestBlock(pad);
+  for (int k = 8; k < 16; k++) b3[k] = _mm256_set1_epi32(int(pad[k]));
+
+  uint32_t tw[8];
+  LoadTargetWords(target, tw);
+  // Byte swap within each 32-bit lane, then an unsigned <= against the top target word.
+  const __m256i bswap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                         3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+  const __m256i top = _mm256_set1_epi32(int(tw[0]));
+
+  alignas(32) uint32_t lanes[8][8];
+  uint32_t found = 0;
+  uint64_t i = 0;
+  while (count - i >= 8) {
+    const uint32_t base = start + uint32_t(i);
+    b2[3] = _mm256_setr_epi32(int(Bswap32(base)), int(Bswap32(base + 1)), int(Bswap32(base + 2)),
+                              int(Bswap32(base + 3)), int(Bswap32(base + 4)), int(Bswap32(base + 5)),
+                              int(Bswap32(base + 6)), int(Bswap32(base + 7)));
+
+    for (int k = 0; k < 8; k++) s[k] = mid[k];
+    Compress8(s, b2);
+    for (int k = 0; k < 8; k++) b3[k] = s[k];
+    for (int k = 0; k < 8; k++) s[k] = _mm256_set1_epi32(int(kSha256IV[k]));
+    Compress8(s, b3);
+
+    const __m256i hi = _mm256_shuffle_epi8(s[7], bswap);
+    const int survivors = _mm256_movemask_ps(_mm256_castsi256_ps(
+        _mm256_cmpeq_epi32(_mm256_min_epu32(hi, top), hi)));
+    if (!survivors) {
+      i += 8;
+      continue;
+    }
+
+    for (int k = 0; k < 8; k++) _mm256_store_si256((__m256i*)lanes[k], s[k]);
+    for (int lane = 0; lane < 8; lane++) {
+      if (!((survivors >> lane) & 1)) continue;
+      uint32_t st[8];
+      for (int k = 0; k < 8; k++) st[k] = lanes[k][lane];
+      if (MeetsTargetWords(st, tw)) {
+        out[found++] = base + uint32_t(lane);
+        if (found >= max_out) {
+          *hashes = i + uint64_t(lane) + 1;
+          return found;
+        }
+      }
+    }
+    i += 8;
+  }
+
+  // Tail shorter than one 8-lane batch.
+  uint64_t rest = 0;
+  if (i < count) {
+    found += ScanScalar(midstate, tail, target, start + uint32_t(i), count - i, out + found, max_out - found, &rest);
+  }
+  *hashes = i + rest;
+  return found;
+}
+
+SOULVAN_TARGET("avx2")
+void Sha256ManyAvx2(const uint8_t* in, size_t stride, size_t count, bool twice, uint8_t* out) {
+  const size_t blocks = PaddedBlocks(stride);
+  uint32_t pad[16];
+  InitDigestBlock(pad);
+
+  __m256i block[16], s[8];
+  alignas(32) uint32_t lanes[16][8];
+  size_t i = 0;
+  for (; count - i >= 8; i += 8) {
+    for (int k = 0; k < 8; k++) s[k] = _mm256_set1_epi32(int(kSha256IV[k]));
+    for (size_t b = 0; b < blocks; b++) {
+      for (int lane = 0; lane < 8; lane++) {
+        uint32_t words[16];
+        LoadPaddedBlock(in + (i + lane) * stride, stride, b, words);
+        for (int k = 0; k < 16; k++) lanes[k][lane] = words[k];
+      }
+      for (int k = 0; k < 16; k++) block[k] = _mm256_load_si256((const __m256i*)lanes[k]);
+      Compress8(s, block);
+    }
+    if (twice) {
+      for (int k = 0; k < 8; k++) block[k] = s[k];
+      for (int k = 8; k < 16; k++) block[k] = _mm256_set1_epi32(int(pad[k]));
+      for (int k = 0; k < 8; k++) s[k] = _mm256_set1_epi32(int(kSha256IV[k]));
+      Compress8(s, block);
+    }
+    for (int k = 0; k < 8; k++) _mm256_store_si256((__m256i*)lanes[k], s[k]);
+    for (int lane = 0; lane < 8; lane++) {
+      for (int k = 0; k < 8; k++) StoreBe32(out + (i + lane) * 32 + k * 4, lanes[k][lane]);
+    }
+  }
+
+  // Fewer than 8 inputs left.
+  if (i < count) Sha256ManyScalar(in + i * stride, stride, count - i, twice, out + i * 32);
+}
+
+}  // namespace soulvan
+
+#endif  // SOULVAN_X86
@@ -0,0 +1,77 @@
+#include "sha256d.h"
+
+namespace soulvan {
+
+const uint32_t kSha256K[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+const uint32_t kSha256IV[8] = {
+  0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static inline uint32_t Rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+void CompressScalar(uint32_t state[8], const uint32_t block[16]) {
+  uint32_t w[64];
+  for (int i = 0; i < 16; i++) w[i] = block[i];
+  for (int i = 16; i < 64; i++) {
+    const uint32_t s0 = Rotr(w[i - 15], 7) ^ Rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    const uint32_t s1 = Rotr(w[i - 2], 17) ^ Rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+  uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+  for (int i = 0; i < 64; i++) {
+    const uint32_t t1 = h + (Rotr(e, 6) ^ Rotr(e, 11) ^ Rotr(e, 25)) + ((e & f) ^ (~e & g)) + kSha256K[i] + w[i];
+    const uint32_t t2 = (Rotr(a, 2) ^ Rotr(a, 13) ^ Rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+    h = g; g = f; f = e; e = d + t1;
+    d = c; c = b; b = a; a = t1 + t2;
+  }
+  state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+  state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+uint32_t ScanScalar(const uint32_t midstate[8], const uint8_t tail[16], const uint8_t target[32],
+                    uint32_t start, uint64_t count,
+                    uint32_t* out, uint32_t max_out, uint64_t* hashes) {
+  uint32_t block2[16], block3[16], state[8];
+  LoadTailBlock(tail, block2);
+  InitDigestBlock(block3);
+  uint32_t tw[8];
+  LoadTargetWords(target, tw);
+
+  uint32_t found = 0;
+  uint64_t i = 0;
+  while (i < count) {
+    const uint32_t nonce = start + uint32_t(i++);
+    block2[3] = Bswap32(nonce);
+
+    for (int k = 0; k < 8; k++) state[k] = midstate[k];
+    CompressScalar(state, block2);
+    for (int k = 0; k < 8; k++) block3[k] = state[k];
+    for (int k = 0; k < 8; k++) state[k] = kSha256IV[k];
+    CompressScalar(state, block3);
+
+    if (Bswap32(state[7]) <= tw[0] && MeetsTargetWords(state, tw)) {
+      out[found++] = nonce;
+      if (found >= max_out) break;
+    }
+  }
+  *hashes = i;
+  return found;
+}
+
+void Sha256ManyScalar(const uint8_t* in, size_t stride, size_t count, bool twice, uint8_t* out) {
+  for (size_t i = 0; i < count; i++) Sha256One(CompressScalar, in + i * stride, stride, twice, out + i * 32);
+}
+
+}  // namespace soulvan
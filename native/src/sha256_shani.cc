@@ -0,0 +1,108 @@
+// Intel SHA extensions kernel. Message words are passed already in host
+// order, so no byte shuffle is needed on load.
+#include "sha256d.h"
+
+#ifdef SOULVAN_X86
+
+#include <immintrin.h>
+
+namespace soulvan {
+
+#define SHANI_QUAD(i, cur, next, prev, msg2, msg1)                                  \
+  msg = _mm_add_epi32(cur, _mm_loadu_si128((const __m128i*)&kSha256K[4 * (i)]));  \
+  s1 = _mm_sha256rnds2_epu32(s1, s0, msg);                                        \
+  if (msg2) {                                                                     \
+    tmp = _mm_alignr_epi8(cur, prev, 4);                                          \
+    next = _mm_add_epi32(next, tmp);                                              \
+    next = _mm_sha256msg2_epu32(next, cur);                                       \
+  }                                                                               \
+  msg = _mm_shuffle_epi32(msg, 0x0E);                                             \
+  s0 = _mm_sha256rnds2_epu32(s0, s1, msg);                                        \
+  if (msg1) prev = _mm_sha256msg1_epu32(prev, cur);
+
+SOULVAN_TARGET("sha,sse4.1")
+static inline void CompressShaNi(uint32_t state[8], const uint32_t block[16]) {
+  __m128i tmp = _mm_loadu_si128((const __m128i*)&state[0]);
+  __m128i s1 = _mm_loadu_si128((const __m128i*)&state[4]);
+  tmp = _mm_shuffle_epi32(tmp, 0xB1);          // CDAB
+  s1 = _mm_shuffle_epi32(s1, 0x1B);            // EFGH
+  __m128i s0 = _mm_alignr_epi8(tmp, s1, 8);    // ABEF
+  s1 = _mm_blend_epi16(s1, tmp, 0xF0);         // CDGH
+
+  const __m128i abef = s0;
+  const __m128i cdgh = s1;
+  __m128i msg;
+  __m128i m0 = _mm_loadu_si128((const __m128i*)&block[0]);
+  __m128i m1 = _mm_loadu_si128((const __m128i*)&block[4]);
+  __m128i m2 = _mm_loadu_si128((const __m128i*)&block[8]);
+  __m128i m3 = _mm_loadu_si128((const __m128i*)&block[12]);
+
+  SHANI_QUAD(0, m0, m1, m3, 0, 0)
+  SHANI_QUAD(1, m1, m2, m0, 0, 1)
+  SHANI_QUAD(2, m2, m3, m1, 0, 1)
+  SHANI_QUAD(3, m3, m0, m2, 1, 1)
+  SHANI_QUAD(4, m0, m1, m3, 1, 1)
+  SHANI_QUAD(5, m1, m2, m0, 1, 1)
+  SHANI_QUAD(6, m2, m3, m1, 1, 1)
+  SHANI_QUAD(7, m3, m0, m2, 1, 1)
+  SHANI_QUAD(8, m0, m1, m3, 1, 1)
+  SHANI_QUAD(9, m1, m2, m0, 1, 1)
+  SHANI_QUAD(10, m2, m3, m1, 1, 1)
+  SHANI_QUAD(11, m3, m0, m2, 1, 1)
+  SHANI_QUAD(12, m0, m1, m3, 1, 1)
+  SHANI_QUAD(13, m1, m2, m0, 1, 0)
+  SHANI_QUAD(14, m2, m3, m1, 1, 0)
+  SHANI_QUAD(15, m3, m0, m2, 0, 0)
+
+  s0 = _mm_add_epi32(s0, abef);
+  s1 = _mm_add_epi32(s1, cdgh);
+
+  tmp = _mm_shuffle_epi32(s0, 0x1B);           // FEBA
+  s1 = _mm_shuffle_epi32(s1, 0xB1);            // DCHG
+  s0 = _mm_blend_epi16(tmp, s1, 0xF0);         // DCBA
+  s1 = _mm_alignr_epi8(s1, tmp, 8);            // ABEF
+  _mm_storeu_si128((__m128i*)&state[0], s0);
+  _mm_storeu_si128((__m128i*)&state[4], s1);
+}
+
+#undef SHANI_QUAD
+
+SOULVAN_TARGET("sha,sse4.1")
+uint32_t ScanShaNi(const uint32_t midstate[8], const uint8_t tail[16], const uint8_t target[32],
+                   uint32_t start, uint64_t count,
+                   uint32_t* out, uint32_t max_out, uint64_t* hashes) {
+  alignas(16) uint32_t block2[16], block3[16], state[8];
+  LoadTailBlock(tail, block2);
+  InitDigestBlock(block3);
+  uint32_t tw[8];
+  LoadTargetWords(target, tw);
+
+  uint32_t found = 0;
+  uint64_t i = 0;
+  while (i < count) {
+    const uint32_t nonce = start + uint32_t(i++);
+    block2[3] = Bswap32(nonce);
+
+    for (int k = 0; k < 8; k++) state[k] = midstate[k];
+    CompressShaNi(state, block2);
+    for (int k = 0; k < 8; k++) block3[k] = state[k];
+    for (int k = 0; k < 8; k++) state[k] = kSha256IV[k];
+    CompressShaNi(state, block3);
+
+    if (Bswap32(state[7]) <= tw[0] && MeetsTargetWords(state, tw)) {
+      out[found++] = nonce;
+      if (found >= max_out) break;
+    }
+  }
+  *hashes = i;
+  return found;
+}
+
+SOULVAN_TARGET("sha,sse4.1")
+void Sha256ManyShaNi(const uint8_t* in, size_t stride, size_t count, bool twice, uint8_t* out) {
+  for (size_t i = 0; i < count; i++) Sha256One(CompressShaNi, in + i * stride, stride, twice, out + i * 32);
+}
+
+}  // namespace soulvan
+
+#endif  // SOULVAN_X86
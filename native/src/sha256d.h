@@ -0,0 +1,161 @@
+// SHA-256d nonce-range kernels for the built-in miner, plus batch hashing of
+// packed fixed-stride inputs (hashMany).
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace soulvan {
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SOULVAN_X86 1
+#endif
+
+#if defined(SOULVAN_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SOULVAN_TARGET(x) __attribute__((target(x)))
+#else
+#define SOULVAN_TARGET(x)
+#endif
+
+extern const uint32_t kSha256K[64];
+extern const uint32_t kSha256IV[8];
+
+struct CpuFeatures {
+  bool sse41 = false;
+  bool sha = false;
+  bool avx2 = false;
+};
+
+CpuFeatures DetectCpu();
+
+// Scans nonces [start, start + count) of an 80-byte header given as the
+// midstate of its first 64 bytes plus the 16-byte tail. Writes up to max_out
+// winning nonces to out and returns how many were written.
+// *hashes receives the number of nonces actually tried.
+using ScanFn = uint32_t (*)(const uint32_t midstate[8], const uint8_t tail[16], const uint8_t target[32],
+                            uint32_t start, uint64_t count,
+                            uint32_t* out, uint32_t max_out, uint64_t* hashes);
+
+uint32_t ScanScalar(const uint32_t midstate[8], const uint8_t tail[16], const uint8_t target[32],
+                    uint32_t start, uint64_t count,
+                    uint32_t* out, uint32_t max_out, uint64_t* hashes);
+#ifdef SOULVAN_X86
+uint32_t ScanShaNi(const uint32_t midstate[8], const uint8_t tail[16], const uint8_t target[32],
+                   uint32_t start, uint64_t count,
+                   uint32_t* out, uint32_t max_out, uint64_t* hashes);
+uint32_t ScanAvx2(const uint32_t midstate[8], const uint8_t tail[16], const uint8_t target[32],
+                  uint32_t start, uint64_t count,
+                  uint32_t* out, uint32_t max_out, uint64_t* hashes);
+#endif
+
+// Hashes count messages of stride bytes laid out back to back in `in` and
+// writes the 32-byte digests back to back to `out`. With twice set each digest
+// is SHA-256d.
+using HashManyFn = void (*)(const uint8_t* in, size_t stride, size_t count, bool twice, uint8_t* out);
+
+void Sha256ManyScalar(const uint8_t* in, size_t stride, size_t count, bool twice, uint8_t* out);
+#ifdef SOULVAN_X86
+void Sha256ManyShaNi(const uint8_t* in, size_t stride, size_t count, bool twice, uint8_t* out);
+void Sha256ManyAvx2(const uint8_t* in, size_t stride, size_t count, bool twice, uint8_t* out);
+#endif
+
+// Same layout for RIPEMD-160 (20-byte digests).
+void Ripemd160Many(const uint8_t* in, size_t stride, size_t count, uint8_t* out);
+
+// Pins the calling thread to one logical CPU; false where unsupported.
+bool PinThread(int cpu);
+// Logical CPU the calling thread is running on, -1 if unknown.
+int CurrentCpu();
+
+void CompressScalar(uint32_t state[8], const uint32_t block[16]);
+
+inline uint32_t Bswap32(uint32_t x) {
+  return (x >> 24) | ((x >> 8) & 0xff00u) | ((x << 8) & 0xff0000u) | (x << 24);
+}
+
+inline uint32_t LoadBe32(const uint8_t* p) {
+  return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+inline void StoreBe32(uint8_t* p, uint32_t v) {
+  p[0] = uint8_t(v >> 24);
+  p[1] = uint8_t(v >> 16);
+  p[2] = uint8_t(v >> 8);
+  p[3] = uint8_t(v);
+}
+
+// Number of 64-byte blocks in a SHA-256 padded message of len bytes.
+inline size_t PaddedBlocks(size_t len) { return (len + 9 + 63) / 64; }
+
+// Block `index` of the SHA-256 padded form of msg[0..len), as 16 big-endian words.
+inline void LoadPaddedBlock(const uint8_t* msg, size_t len, size_t index, uint32_t block[16]) {
+  const size_t off = index * 64;
+  if (off + 64 <= len) {
+    for (int i = 0; i < 16; i++) block[i] = LoadBe32(msg + off + i * 4);
+    return;
+  }
+  uint8_t buf[64];
+  for (size_t j = 0; j < 64; j++) {
+    const size_t p = off + j;
+    buf[j] = p < len ? msg[p] : p == len ? 0x80 : 0;
+  }
+  if (index == PaddedBlocks(len) - 1) {
+    const uint64_t bits = uint64_t(len) * 8;
+    for (int j = 0; j < 8; j++) buf[56 + j] = uint8_t(bits >> (56 - 8 * j));
+  }
+  for (int i = 0; i < 16; i++) block[i] = LoadBe32(buf + i * 4);
+}
+
+// Padded tail block (header bytes 64..79); the nonce word is block2[3].
+inline void LoadTailBlock(const uint8_t tail[16], uint32_t block2[16]) {
+  for (int i = 0; i < 16; i++) block2[i] = 0;
+  for (int i = 0; i < 4; i++) block2[i] = LoadBe32(tail + i * 4);
+  block2[4] = 0x80000000u;
+  block2[15] = 80 * 8;
+}
+
+// Padding for hashing a 32-byte digest; words 0..7 are filled per nonce.
+inline void InitDigestBlock(uint32_t block[16]) {
+  for (int i = 8; i < 16; i++) block[i] = 0;
+  block[8] = 0x80000000u;
+  block[15] = 32 * 8;
+}
+
+// SHA-256 (SHA-256d when twice) of one message using `compress` for each block.
+template <typename Compress>
+inline void Sha256One(Compress compress, const uint8_t* msg, size_t len, bool twice, uint8_t out[32]) {
+  uint32_t state[8], block[16];
+  for (int k = 0; k < 8; k++) state[k] = kSha256IV[k];
+  const size_t blocks = PaddedBlocks(len);
+  for (size_t b = 0; b < blocks; b++) {
+    LoadPaddedBlock(msg, len, b, block);
+    compress(state, block);
+  }
+  if (twice) {
+    for (int k = 0; k < 8; k++) block[k] = state[k];
+    InitDigestBlock(block);
+    for (int k = 0; k < 8; k++) state[k] = kSha256IV[k];
+    compress(state, block);
+  }
+  for (int k = 0; k < 8; k++) StoreBe32(out + k * 4, state[k]);
+}
+
+// Target (32 bytes big-endian, matching mining/target.js) as 8 words, most
+// significant first.
+inline void LoadTargetWords(const uint8_t target[32], uint32_t words[8]) {
+  for (int i = 0; i < 8; i++) words[i] = LoadBe32(target + i * 4);
+}
+
+// True when the final state, read as a little-endian 256-bit number, is <= target.
+// state[7] carries the most significant word, so kernels test
+// Bswap32(state[7]) <= words[0] first and only call this for survivors.
+inline bool MeetsTargetWords(const uint32_t state[8], const uint32_t words[8]) {
+  for (int i = 0; i < 8; i++) {
+    const uint32_t h = Bswap32(state[7 - i]);
+    if (h < words[i]) return true;
+    if (h > words[i]) return false;
+  }
+  return true;
+}
+
+}  // namespace soulvan
@@ -0,0 +1,164 @@
+const crypto = require('crypto');
+const { hashMany } = require('../mining/hash_many');
+const pow = require('../mining/pow');
+const { BatchSizer } = require('../mining/batch_sizer');
+const { searchSeeded } = require('../mining/deterministic');
+const { defaultThreads } = require('../mining/worker_pool');
+const { encode, FrameDecoder } = require('../mining/stratum_v2');
+
+// Runs in the app's main process, so slices are sized like the in-process miner's.
+const SLICE_MS = 8;
+const MAX_BATCH = 1 << 16;
+const STRIDE = 32;
+
+// Header scan with an unreachable target, so every nonce is a full PoW hash.
+// Every registered algorithm goes through the same loop; the first batch is
+// scaled by its declared cost and later ones follow the measured slice time.
+async function runNonceSearch(seconds, name = 'sha256d') {
+  const algo = pow.get(name);
+  const search = algo.createSearch(Buffer.alloc(80), Buffer.alloc(32));
+  const sizer = new BatchSizer({ targetMs: SLICE_MS, initial: 5000 / algo.cost.relative });
+  const end = Date.now() + seconds * 1000;
+  const started = process.hrtime.bigint();
+  let hashes = 0;
+  while (Date.now() < end) {
+    if (search.exhausted) search.setRange(0);
+    const done = search.scan(sizer.start()).hashes;
+    sizer.done(done);
+    hashes += done;
+    await new Promise(r => setImmediate(r));
+  }
+  const elapsed = Number(process.hrtime.bigint() - started) / 1e9;
+  return {
+    algorithm: algo.name,
+    engine: algo.impl,
+    cost: algo.cost,
+    batch: sizer.size,
+    totalHashes: hashes,
+    hashesPerSecond: Math.round(hashes / elapsed)
+  };
+}
+
+// Seeded search on the worker pool: every run does exactly the same work
+// (same solution after the same hash count), so elapsed time compares across
+// builds and machines without sampling noise in the amount of work.
+const FIXTURE = { seed: 1, bits: 0x1e0fffff, nonce: 2186249722, hashes: 3900923 };
+
+async function runFixture(threads = defaultThreads()) {
+  const r = await searchSeeded({ seed: FIXTURE.seed, bits: FIXTURE.bits, threads });
+  return {
+    seed: FIXTURE.seed,
+    threads,
+    nonce: r.nonce,
+    hashes: r.hashes,
+    correct: r.nonce === FIXTURE.nonce && r.hashes === FIXTURE.hashes,
+    elapsedMs: r.elapsedMs,
+    hashesPerSecond: r.hashrate
+  };
+}
+
+// Per-share overhead of Stratum v1 (JSON lines) against v2 (binary frames):
+// wire bytes of a submit and its answer, and the CPU to encode and decode
+// both ends of them, plus the size of one job announcement. No sockets, so
+// this is the protocols' own cost. v2 is measured with one ack per share;
+// pools that batch acks save more.
+function runProtocolOverhead(shares = 100000) {
+  const nonces = Array.from({ length: shares }, () => crypto.randomInt(2 ** 32));
+  const branch = Array.from({ length: 12 }, () => crypto.randomBytes(32));
+  const coinb1 = crypto.randomBytes(60);
+  const coinb2 = crypto.randomBytes(80);
+  const prevHash = crypto.randomBytes(32);
+
+  const notify = `${JSON.stringify({
+    id: null,
+    method: 'mining.notify',
+    params: ['1a2b', prevHash.toString('hex'), coinb1.toString('hex'), coinb2.toString('hex'),
+      branch.map(h => h.toString('hex')), '20000000', '1d00ffff', '6553f100', true]
+  })}\n`;
+  const prev = encode('SetNewPrevHash', { channelId: 1, jobId: 7, prevHash, minNtime: 1700000000, nbits: 0x1d00ffff });
+  const standardJob = encode('NewMiningJob', { channelId: 1, jobId: 7, minNtime: null, version: 0x20000000, merkleRoot: prevHash });
+  const extendedJob = encode('NewExtendedMiningJob', {
+    channelId: 1, jobId: 7, minNtime: null, version: 0x20000000, versionRollingAllowed: false,
+    merklePath: branch, coinbaseTxPrefix: coinb1, coinbaseTxSuffix: coinb2
+  });
+
+  // One submit + answer round of each protocol; returns wire bytes.
+  const v1Round = (i) => {
+    const nonce = nonces[i].toString(16).padStart(8, '0');
+    const submit = `${JSON.stringify({ id: i, method: 'mining.submit', params: ['worker.1', '1a2b', '00000001', '6553f100', nonce] })}\n`;
+    const req = JSON.parse(submit);
+    const answer = `${JSON.stringify({ id: req.id, result: true, error: null })}\n`;
+    JSON.parse(answer);
+    return Buffer.byteLength(submit) + Buffer.byteLength(answer);
+  };
+  const server = new FrameDecoder();
+  const client = new FrameDecoder();
+  const v2Round = (i) => {
+    const submit = encode('SubmitSharesStandard', {
+      channelId: 1, sequenceNumber: i, jobId: 7, nonce: nonces[i], ntime: 1700000000, version: 0x20000000
+    });
+    const [{ msg }] = server.push(submit);
+    const answer = encode('SubmitSharesSuccess', {
+      channelId: 1, lastSequenceNumber: msg.sequenceNumber, newSubmitsAcceptedCount: 1, newSharesSum: 1
+    });
+    client.push(answer);
+    return submit.length + answer.length;
+  };
+  // Bytes and µs per share; a warm-up pass first so both are JIT-compiled.
+  const measure = (round) => {
+    for (let i = 0; i < shares / 10; i++) round(i);
+    let bytes = 0;
+    const started = process.hrtime.bigint();
+    for (let i = 0; i < shares; i++) bytes += round(i);
+    const us = Number(process.hrtime.bigint() - started) / 1e3 / shares;
+    return { bytesPerShare: Math.round(bytes / shares), usPerShare: +us.toFixed(2) };
+  };
+  const v1 = measure(v1Round);
+  const v2 = measure(v2Round);
+
+  return {
+    shares,
+    v1: { ...v1, jobBytes: Buffer.byteLength(notify) },
+    v2: {
+      ...v2,
+      standardJobBytes: standardJob.length + prev.length,
+      extendedJobBytes: extendedJob.length + prev.length
+    }
+  };
+}
+
+// Plain SHA-256 throughput, one packed batch per hashMany call, and the
+// sha256d nonce search. The app's IPC benchmark stops there: it runs in the
+// main process, and the protocol section is one long synchronous loop.
+// extended (the CLI) adds every other algorithm, the seeded fixture and the
+// Stratum protocol overhead.
+async function run(seconds = 5, { extended = false } = {}) {
+  const inputs = crypto.randomBytes(MAX_BATCH * STRIDE);
+  const sizer = new BatchSizer({ targetMs: SLICE_MS, initial: 5000, max: MAX_BATCH });
+  const end = Date.now() + seconds * 1000;
+  let hashes = 0;
+  while (Date.now() < end) {
+    const batch = sizer.start();
+    hashMany('sha256', inputs, STRIDE, batch);
+    sizer.done(batch);
+    hashes += batch;
+    await new Promise(r => setImmediate(r));
+  }
+  const hps = hashes / seconds;
+  const nonceSearch = await runNonceSearch(seconds);
+  const result = { seconds, totalHashes: hashes, hashesPerSecond: Math.round(hps), batch: sizer.size, nonceSearch };
+  if (!extended) return result;
+  // The other algorithms share one more `seconds` between them.
+  const others = pow.list().filter(a => a.name !== 'sha256d');
+  const algorithms = [nonceSearch];
+  for (const a of others) algorithms.push(await runNonceSearch(Math.max(0.5, seconds / others.length), a.name));
+  const fixture = await runFixture();
+  const protocol = runProtocolOverhead();
+  return { ...result, algorithms, fixture, protocol };
+}
+
+if (require.main === module) {
+  run(Number(process.argv[2] || 5), { extended: true }).then(r => console.log(JSON.stringify(r, null, 2)));
+}
+
+module.exports = { run, runFixture, runProtocolOverhead, FIXTURE };
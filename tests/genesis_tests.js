@@ -0,0 +1,143 @@
+const assert = require('assert');
+const genesis = require('../genesis/genesis_builder');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { computeMidstate } = require('../mining/nonce_search');
+const { SearchCheckpoint, addRange, freeRanges } = require('../mining/checkpoint');
+const { NonceScheduler } = require('../mining/scheduler');
+const { WorkerPool } = require('../mining/worker_pool');
+const pow = require('../mining/pow');
+const { meetsTarget, bitsToTarget } = require('../mining/target');
+const { sha256d } = require('../mining/sha256');
+const { CoinbaseLayout, genesisScriptSig } = require('../genesis/coinbase');
+
+function testRollover() {
+  const { roller, header } = genesis.prepare({ timeWindow: 2 });
+  const t1 = roller.next();
+  const t2 = roller.next();
+  assert.strictEqual(t1.nTime, header.readUInt32LE(68) + 1);
+  assert.strictEqual(t2.nTime, header.readUInt32LE(68) + 2);
+  assert.deepStrictEqual(t2.midstate, t1.midstate, 'nTime rolls keep the midstate');
+  const t3 = roller.next();
+  assert.strictEqual(t3.extranonce, 1);
+  assert.strictEqual(t3.nTime, header.readUInt32LE(68));
+  assert.notDeepStrictEqual(t3.header.subarray(36, 68), header.subarray(36, 68), 'extranonce roll changes the merkle root');
+  assert.deepStrictEqual(t3.midstate, computeMidstate(t3.header));
+  assert.deepStrictEqual(t3.header.subarray(36, 68), sha256d(t3.coinbase), 'midstate txid matches a full hash');
+  // Long messages too: every roll hashes at most two blocks of the coinbase.
+  for (const len of [0, 40, 71, 150, 300]) {
+    const layout = new CoinbaseLayout({ scriptSig: genesisScriptSig('x'.repeat(len)), outputScript: Buffer.alloc(67), reward: 1n });
+    const coinbase = layout.coinbaseFor(0xdeadbeef);
+    assert.deepStrictEqual(layout.txidFor(coinbase), sha256d(coinbase));
+    assert.ok(layout.blocksPerRoll <= 2, `message of ${len}: ${layout.blocksPerRoll} blocks per roll`);
+  }
+  // The scriptSig carries the spec's own nBits.
+  const forked = genesis.prepare({ nBits: '0x1e0ffff0', message: 'fork' }).coinbase;
+  assert.ok(forked.includes(genesisScriptSig('fork', 0x1e0ffff0)));
+  assert.ok(!forked.includes(genesisScriptSig('fork')));
+  console.log('PASS: template roller bumps nTime, then rolls the extranonce.');
+}
+
+function testCheckpointResume() {
+  const ranges = [];
+  addRange(ranges, 100, 200);
+  addRange(ranges, 300, 400);
+  addRange(ranges, 200, 300);
+  assert.deepStrictEqual(ranges, [[100, 400]]);
+  assert.deepStrictEqual(freeRanges([[100, 400], [500, 600]], 0, 1000), [[0, 100], [400, 500], [600, 1000]]);
+
+  const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'soulvan-cp-'));
+  const params = { job: 'test' };
+  const cp = new SearchCheckpoint({ dir, params });
+  cp.markDone(0, 0, 0, 0xfffff000);
+  cp.markDone(1, 1, 0, 0x1000);
+  cp.setCursor({ index: 1, extranonce: 1, nTime: 1231006505 });
+  cp.save();
+
+  const resume = new SearchCheckpoint({ dir, params }).load();
+  assert.strictEqual(resume.rolled, 1);
+  const { roller } = genesis.prepare({});
+  const sched = new NonceScheduler({ workers: 2, roller, resume });
+  sched.record(0, 1e12, 1000);
+  sched.record(1, 1e12, 1000);
+  const handed = new Map([[0, []], [1, []]]);
+  for (let n = 0; ; n++) {
+    const u = sched.next(n % 2);
+    if (u.template.index > 1) break;
+    addRange(handed.get(u.template.index), u.start, u.end);
+  }
+  assert.deepStrictEqual(handed.get(0), [[0xfffff000, 0x100000000]], 'template 0 resumes after its finished range');
+  assert.deepStrictEqual(handed.get(1), [[0x1000, 0x100000000]], 'template 1 resumes after its finished range');
+  assert.strictEqual(new SearchCheckpoint({ dir, params: { job: 'other' } }).load(), null);
+
+  // Templates below the scheduler's oldest live one collapse into doneBelow.
+  const long = new SearchCheckpoint({ dir, params: { job: 'long' } });
+  for (let t = 0; t < 3; t++) long.markDone(0, t, 0, t < 2 ? 0x100000000 : 0x2000);
+  long.setCursor({ index: 2, extranonce: 0, nTime: 1231006507, oldest: 2 });
+  long.save();
+  const saved = JSON.parse(fs.readFileSync(long.file, 'utf8'));
+  assert.deepStrictEqual(saved.workers[0].ranges, [[2, 0, 0x2000]]);
+  const tail = new NonceScheduler({ workers: 1, roller: genesis.prepare({}).roller, resume: new SearchCheckpoint({ dir, params: { job: 'long' } }).load() });
+  const first = tail.next(0);
+  assert.deepStrictEqual([first.template.index, first.start], [2, 0x2000]);
+  fs.rmSync(dir, { recursive: true, force: true });
+  console.log('PASS: checkpoint round-trips and resumes only unfinished ranges.');
+}
+
+(async () => {
+  const job = genesis.prepare({});
+  assert.strictEqual(Buffer.from(job.merkleRoot).reverse().toString('hex'),
+    '4a5e1e4baab89f3a32518a88c31bc87f618f76673e2cc77ab2127b7afdeda33b');
+  console.log('PASS: genesis coinbase reproduces the Bitcoin merkle root.');
+  testRollover();
+  testCheckpointResume();
+
+  console.log('Searching for the Bitcoin genesis nonce...');
+  const r = await genesis.build({ nonceStart: 2083236893 - 20000, threads: 1 });
+  assert.ok(r.ok);
+  assert.strictEqual(r.nonce, 2083236893);
+  assert.strictEqual(r.hash, '000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f');
+  assert.ok(r.block.startsWith(r.header + '01' + r.coinbase.slice(0, 8)), 'block = header | tx count | coinbase');
+  console.log('PASS: genesis builder found the Bitcoin genesis block.');
+
+  const fork = await genesis.build({ coin: 'soulvan-scrypt', nBits: '0x2000ffff', threads: 2 });
+  assert.strictEqual(fork.algorithm, 'scrypt');
+  const digest = pow.get('scrypt').hash(Buffer.from(fork.header, 'hex'));
+  assert.strictEqual(Buffer.from(digest).reverse().toString('hex'), fork.hash);
+  assert.ok(meetsTarget(digest, bitsToTarget(0x2000ffff)));
+  console.log('PASS: genesis builder mines a scrypt fork from the coin config.');
+
+  // Mixed difficulties and algorithms share one pool; each spec gets its own result.
+  const batch = await genesis.buildBatch([
+    { name: 'mainnet', nonceStart: 2083236893 - 20000 },
+    { name: 'regtest', nBits: '0x207fffff', nTime: 1296688602 },
+    { name: 'scrypt', coin: 'soulvan-scrypt', nBits: '0x2000ffff' }
+  ], null, { threads: 2 });
+  assert.ok(batch.ok);
+  assert.deepStrictEqual(batch.results.map(x => x.name), ['mainnet', 'regtest', 'scrypt']);
+  assert.strictEqual(batch.results[0].nonce, 2083236893);
+  assert.strictEqual(batch.results[2].algorithm, 'scrypt');
+  for (const res of batch.results) {
+    const algo = pow.get(res.algorithm);
+    assert.ok(meetsTarget(algo.hash(Buffer.from(res.header, 'hex')), bitsToTarget(parseInt(res.nBits, 16))));
+  }
+  console.log('PASS: batch build solves several specs on one pool.');
+
+  // A worker that dies fails the build instead of leaving it pending.
+  const start = WorkerPool.prototype.start;
+  WorkerPool.prototype.start = function (...args) {
+    start.apply(this, args);
+    this.workers[0].terminate();
+  };
+  try {
+    await assert.rejects(genesis.build({ threads: 2 }), /worker 0 exited/);
+    await assert.rejects(genesis.buildBatch([{}, { nTime: 1 }], null, { threads: 2 }), /worker 0 exited/);
+  } finally {
+    WorkerPool.prototype.start = start;
+  }
+  console.log('PASS: a failed worker rejects single and batch builds.');
+})().catch(e => {
+  console.error('FAIL:', e);
+  process.exit(1);
+});
@@ -0,0 +1,450 @@
+const assert = require('assert');
+const crypto = require('crypto');
+const net = require('net');
+const miner = require('../mining/miner_core');
+const { NonceSearch, computeMidstate } = require('../mining/nonce_search');
+const native = require('../mining/native');
+const { bitsToTarget } = require('../mining/target');
+const { NonceScheduler } = require('../mining/scheduler');
+const { TemplateRoller } = require('../mining/template_roller');
+const { hashMany } = require('../mining/hash_many');
+const pow = require('../mining/pow');
+const { HashrateEstimator } = require('../mining/hashrate');
+const { DutyCycle } = require('../mining/throttle');
+const { IdleScheduler } = require('../mining/idle_scheduler');
+const { LoadSampler } = require('../mining/system_load');
+const { keccak256 } = require('../mining/pow/keccak');
+const topology = require('../mining/topology');
+const { SharedStats, SLOT_BYTES } = require('../mining/shared_stats');
+const { searchSeeded } = require('../mining/deterministic');
+const { merkleRoot, CoinbaseMerkle } = require('../mining/merkle');
+const poolMining = require('../mining/pool_mining');
+const { MockPool, MockPoolV2 } = require('../mining/mock_pool');
+const { StratumProxy, ensureProxy, stopProxy } = require('../mining/stratum_proxy');
+const { encode, FrameDecoder } = require('../mining/stratum_v2');
+
+// Bitcoin mainnet genesis header, nonce 2083236893.
+const BTC_GENESIS_HEADER = Buffer.from(
+  '01000000' + '00'.repeat(32) +
+  '3ba3edfd7a7b12b27ac72c3e67768f617fc81bc3888a51323a9fb8aa4b1e5e4a' +
+  '29ab5f49' + 'ffff001d' + '1dac2b7c', 'hex');
+const BTC_GENESIS_NONCE = 2083236893;
+const BTC_GENESIS_HASH = '000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f';
+
+function testNonceSearch() {
+  const search = new NonceSearch(BTC_GENESIS_HEADER, bitsToTarget(0x1d00ffff));
+  search.setRange(BTC_GENESIS_NONCE - 500, BTC_GENESIS_NONCE + 500);
+  const res = search.scan(1000);
+  assert.ok(res.found, 'should find the genesis nonce');
+  assert.strictEqual(res.nonce, BTC_GENESIS_NONCE);
+  assert.strictEqual(res.hash, BTC_GENESIS_HASH);
+  assert.strictEqual(res.hashes, 501);
+  console.log('PASS: nonce search reproduces the Bitcoin genesis hash.');
+}
+
+function testNativeKernels() {
+  if (!native.available) {
+    console.log('SKIP: native addon not built (npm run build:native).');
+    return;
+  }
+  const cpu = native.addon.cpuFeatures();
+  const kernels = ['scalar'].concat(cpu.sha ? ['sha-ni'] : [], cpu.avx2 ? ['avx2'] : []);
+  const target = bitsToTarget(0x1d00ffff);
+  const easy = bitsToTarget(0x1f00ffff);
+  const mid = Buffer.alloc(32);
+  computeMidstate(BTC_GENESIS_HEADER).forEach((w, i) => mid.writeUInt32BE(w, i * 4));
+  const tail = BTC_GENESIS_HEADER.subarray(64, 80);
+  const js = new NonceSearch(BTC_GENESIS_HEADER, easy);
+  js.setRange(0, 300000);
+  const expected = [];
+  while (!js.exhausted) {
+    const res = js.scan(300000);
+    if (res.found) expected.push(res.nonce);
+  }
+  for (const k of kernels) {
+    const hit = native.addon.scanRange(mid, tail, target, BTC_GENESIS_NONCE - 13, 100, 4, k);
+    assert.deepStrictEqual(hit, [BTC_GENESIS_NONCE], `${k} should find the genesis nonce`);
+    const winners = native.addon.scanRange(mid, tail, easy, 0, 300000, 1000, k);
+    assert.deepStrictEqual(winners, expected, `${k} should agree with the JS search`);
+  }
+  console.log(`PASS: native kernels (${kernels.join(', ')}) agree with the JS search.`);
+}
+
+// Odd strides cover inputs that span blocks and the 8-lane remainder.
+function testHashMany() {
+  const cpu = native.available ? native.addon.cpuFeatures() : {};
+  const kernels = native.available ? ['scalar'].concat(cpu.sha ? ['sha-ni'] : [], cpu.avx2 ? ['avx2'] : []) : [];
+  for (const stride of [0, 32, 55, 64, 80, 119]) {
+    const count = 13;
+    const packed = crypto.randomBytes(stride * count);
+    for (const algorithm of ['sha256', 'sha256d', 'ripemd160']) {
+      const out = hashMany(algorithm, packed, stride, count);
+      const size = out.length / count;
+      for (let i = 0; i < count; i++) {
+        const item = packed.subarray(i * stride, (i + 1) * stride);
+        const expected = algorithm === 'sha256d'
+          ? miner.sha256d(item)
+          : crypto.createHash(algorithm).update(item).digest();
+        assert.ok(out.subarray(i * size, (i + 1) * size).equals(expected), `${algorithm} stride ${stride} item ${i}`);
+      }
+      for (const k of kernels) {
+        assert.ok(native.addon.hashMany(algorithm, packed, stride, count, k).equals(out), `${k} ${algorithm} stride ${stride}`);
+      }
+    }
+  }
+  console.log(`PASS: hashMany (${native.impl}) matches node crypto.`);
+}
+
+// Every registered algorithm's search must report hashes its own hash() confirms.
+function testPowRegistry() {
+  assert.strictEqual(keccak256(Buffer.alloc(0)).toString('hex'),
+    'c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470');
+  assert.strictEqual(keccak256(Buffer.from('abc')).toString('hex'),
+    '4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45');
+  const target = bitsToTarget(0x2000ffff);
+  for (const { name } of pow.list()) {
+    const algo = pow.get(name);
+    const search = algo.createSearch(Buffer.alloc(80), target);
+    const res = search.scan(5000);
+    assert.ok(res.found, `${name} should find a 1-in-256 share`);
+    const header = Buffer.alloc(80);
+    header.writeUInt32LE(res.nonce, 76);
+    assert.strictEqual(Buffer.from(algo.hash(header)).reverse().toString('hex'), res.hash, `${name} hash`);
+  }
+  console.log(`PASS: PoW registry (${pow.list().map(a => a.name).join(', ')}) searches verify.`);
+}
+
+// A steady rate must read the same in every window, whether it arrives as hash
+// counts or as reported rates at uneven intervals.
+function testHashrateEstimator() {
+  const counts = new HashrateEstimator(0n);
+  const rates = new HashrateEstimator(0n);
+  let t = 0n;
+  for (let i = 0; i < 20; i++) {
+    t += BigInt(1e9);
+    counts.addHashes(5000, t);
+  }
+  for (const sec of [3, 4, 11, 20]) rates.addRate(5000, BigInt(sec * 1e9));
+  for (const est of [counts, rates]) {
+    const { hashrates, totalHashes } = est.snapshot();
+    assert.deepStrictEqual(hashrates, { '10s': 5000, '60s': 5000, '15m': 5000, session: 5000 });
+    assert.strictEqual(totalHashes, 100000);
+  }
+  console.log('PASS: hashrate estimator averages steady rates in every window.');
+}
+
+function testDutyCycle() {
+  const duty = new DutyCycle(25);
+  assert.strictEqual(duty.owed(10), 30, '25% sleeps 3x the compute time');
+  duty.slept(35);
+  assert.strictEqual(duty.owed(10), 25, 'timer overshoot is paid back');
+  duty.set(100);
+  assert.strictEqual(duty.owed(10), 0);
+  duty.set(0);
+  assert.ok(duty.paused);
+  console.log('PASS: duty cycle sleeps in proportion to compute time.');
+}
+
+// Foreground load takes cores back at once; they return one at a time after
+// staying free for several samples.
+function testIdleScheduler() {
+  const applied = [];
+  const sched = new IdleScheduler({ min: 1, max: 8, sampler: { cpus: 8 }, apply: (n) => applied.push(n) });
+  const load = (foreignCores) => ({ cpus: 8, foreignCores, loadavg1: 1 });
+  sched.step(load(3));
+  assert.strictEqual(sched.active, 5, 'shrinks to the free cores');
+  sched.step(load(1));
+  sched.step(load(1));
+  assert.strictEqual(sched.active, 5, 'holds while the growth streak builds');
+  const d = sched.step(load(1));
+  assert.strictEqual(sched.active, 6);
+  assert.strictEqual(d.reason, 'system idle');
+  sched.step(load(7.5));
+  assert.strictEqual(sched.active, 1, 'never below min');
+  assert.deepStrictEqual(applied, [5, 6, 1]);
+
+  // An external miner restarted between samples: the new pid's time is still
+  // the miner's own, not foreign load.
+  const ticks = new Map([[100, 50000]]);
+  let pids = [100];
+  const sampler = new LoadSampler({ pids: () => pids, readTicks: pid => ticks.get(pid) || 0 });
+  pids = [200];
+  ticks.set(200, 40);
+  const cur = sampler._read();
+  assert.strictEqual(sampler._ownTicks(cur), 40);
+  console.log('PASS: idle scheduler shrinks fast and grows with hysteresis.');
+}
+
+function testTopologyPlacement() {
+  assert.deepStrictEqual(topology.parseCpuList('0-2,8,10-11\n'), [0, 1, 2, 8, 10, 11]);
+  // Two sockets, two cores each, hyperthread siblings numbered +4 (as Linux does).
+  const cpus = [];
+  for (let cpu = 0; cpu < 8; cpu++) {
+    const pkg = (cpu % 4) >> 1;
+    cpus.push({ cpu, node: pkg, package: pkg, core: cpu % 2 });
+  }
+  const plan = topology.placement(6, cpus).map(p => p.cpu);
+  assert.deepStrictEqual(plan, [0, 1, 4, 5, 2, 3], 'node 0 cores, then its siblings, then node 1');
+  // A second pinned miner gets the CPUs the first leaves free.
+  const first = topology.claim('a', 2, cpus).map(p => p.cpu);
+  const second = topology.claim('b', 2, cpus).map(p => p.cpu);
+  assert.deepStrictEqual([first, second], [[0, 1], [4, 5]]);
+  topology.release('a');
+  assert.deepStrictEqual(topology.claim('c', 2, cpus).map(p => p.cpu), [0, 1]);
+  topology.release('b');
+  topology.release('c');
+  assert.deepStrictEqual(topology.summary(cpus), { nodes: 2, packages: 2, cores: 4, threads: 8 });
+  console.log('PASS: topology placement fills a node core by core before siblings.');
+}
+
+function testSharedStats() {
+  const main = new SharedStats(2);
+  assert.strictEqual(main.buffer.byteLength, 2 * SLOT_BYTES, 'one cache line per worker');
+  const worker = new SharedStats(2, main.buffer);
+  worker.addHashes(1, 1000);
+  worker.addHashes(1, 500);
+  worker.setBatch(1, 250);
+  worker.addShare(1, '00000000ffff' + '00'.repeat(26)); // difficulty 1
+  worker.addShare(1, '00000001ffff' + '00'.repeat(26));
+  assert.deepStrictEqual(main.read(0), {
+    hashes: 0, shares: 0, bestDifficulty: 0, batch: 0, wastedHashes: 0, switches: 0, switchMs: 0
+  });
+  const slot = main.read(1);
+  assert.strictEqual(slot.hashes, 1500);
+  assert.strictEqual(slot.shares, 2);
+  assert.strictEqual(slot.batch, 250);
+  assert.strictEqual(slot.bestDifficulty, 1, 'best share keeps the lower hash');
+  assert.strictEqual(main.total().hashes, 1500);
+  console.log('PASS: shared stats slots are written by workers and summed by the reader.');
+}
+
+function testWorkStealing() {
+  const roller = new TemplateRoller({ header: BTC_GENESIS_HEADER });
+  const sched = new NonceScheduler({ workers: 2, roller });
+  sched.record(0, 1e12, 1000); // fast worker: max-size chunks
+  sched.record(1, 1e3, 1000);  // slow worker: min-size chunks
+  const ranges = [];
+  const owners = [0, 0];
+  while (true) {
+    const w = ranges.length % 50 === 49 ? 1 : 0;
+    const unit = sched.next(w);
+    if (unit.template.index !== 0) break;
+    ranges.push([unit.start, unit.end]);
+    owners[w] += unit.end - unit.start;
+  }
+  ranges.sort((a, b) => a[0] - b[0]);
+  let pos = 0;
+  for (const [start, end] of ranges) {
+    assert.strictEqual(start, pos, 'chunks must be disjoint and contiguous');
+    pos = end;
+  }
+  assert.strictEqual(pos, 0x100000000, 'template 0 must be fully covered');
+  assert.ok(owners[0] > 0x80000000, 'fast worker should steal from the slow one');
+  assert.ok(sched.workerStats()[0].steals > 0);
+  console.log('PASS: work-stealing scheduler covers the nonce space exactly once.');
+}
+
+(async () => {
+  testNonceSearch();
+  testWorkStealing();
+  testNativeKernels();
+  testHashMany();
+  testPowRegistry();
+  testHashrateEstimator();
+  testDutyCycle();
+  testIdleScheduler();
+  testTopologyPlacement();
+  testSharedStats();
+
+  // Same seed: same share after the same hash count, whatever the thread count.
+  const one = await searchSeeded({ seed: 42, threads: 1 });
+  const two = await searchSeeded({ seed: 42, threads: 2 });
+  assert.strictEqual(one.nonce, 4231644725);
+  assert.strictEqual(one.hashes, 50742);
+  assert.deepStrictEqual([two.nonce, two.hashes, two.hash], [one.nonce, one.hashes, one.hash]);
+  assert.throws(() => miner.start({ seed: 1, idle: true }), /idle/);
+  console.log('PASS: seeded search is reproducible across thread counts.');
+
+  // Naive tree, duplicating the last node of odd levels.
+  const naiveRoot = (level) => {
+    while (level.length > 1) {
+      const up = [];
+      for (let i = 0; i < level.length; i += 2) {
+        up.push(miner.sha256d(Buffer.concat([level[i], level[i + 1] || level[i]])));
+      }
+      level = up;
+    }
+    return level[0];
+  };
+  for (const n of [1, 2, 3, 5, 8, 13]) {
+    const txids = Array.from({ length: n }, () => crypto.randomBytes(32));
+    assert.deepStrictEqual(merkleRoot(txids), naiveRoot(txids), `merkle root of ${n}`);
+    const coinbase = crypto.randomBytes(100);
+    const rest = txids.slice(1);
+    assert.deepStrictEqual(new CoinbaseMerkle(rest).rootFor(coinbase),
+      naiveRoot([miner.sha256d(coinbase), ...rest]), `coinbase branch of ${n}`);
+  }
+  console.log('PASS: cached coinbase branch gives the full merkle root.');
+
+  console.log('Starting miner test for 2 seconds...');
+  let seenStat = false;
+  let last = null;
+  const id = miner.start({ coin: 'soulvan', address: 'TEST', mode: 'solo' }, (stats) => {
+    seenStat = true;
+    last = stats;
+    assert.ok(typeof stats.hashrate === 'number', 'hashrate should be number');
+    assert.ok(stats.batch > 0, 'stats should report the adaptive batch size');
+  });
+  await new Promise(r => setTimeout(r, 1000));
+  assert.ok(miner.newJob(id, { prevHash: crypto.randomBytes(32) }).ok, 'job switch on a running miner');
+  await new Promise(r => setTimeout(r, 1500));
+  miner.stop(id);
+  assert.ok(seenStat, 'Should have received at least one stats update');
+  assert.strictEqual(last.jobs.switches, 1);
+  assert.ok(last.jobs.wastedHashes >= 0);
+  console.log('PASS: miner emitted stats and stopped cleanly.');
+
+  const until = async (cond, ms = 10000) => {
+    const end = Date.now() + ms;
+    while (!cond() && Date.now() < end) await new Promise(r => setTimeout(r, 50));
+  };
+  // Stratum v1 and v2 (header-only and extended channels) against the local
+  // mock pools, which re-hash every share.
+  const frame = encode('NewExtendedMiningJob', {
+    channelId: 3, jobId: 9, minNtime: null, version: 4, versionRollingAllowed: true,
+    merklePath: [Buffer.alloc(32, 1)], coinbaseTxPrefix: Buffer.from('ab', 'hex'), coinbaseTxSuffix: Buffer.alloc(300)
+  });
+  const [decoded] = new FrameDecoder().push(frame);
+  assert.strictEqual(decoded.name, 'NewExtendedMiningJob');
+  assert.deepStrictEqual(decoded.msg.merklePath, [Buffer.alloc(32, 1)]);
+  assert.strictEqual(decoded.msg.coinbaseTxSuffix.length, 300);
+  // A frame whose length field cuts the payload short is refused.
+  const cut = Buffer.from(frame.subarray(0, 40));
+  cut.writeUIntLE(cut.length - 6, 3, 3);
+  assert.throws(() => new FrameDecoder().push(cut), RangeError);
+  for (const [Pool, scheme, channel] of [[MockPool, 'stratum'], [MockPoolV2, 'stratum2', 'standard'], [MockPoolV2, 'stratum2', 'extended']]) {
+    const mock = new Pool();
+    const port = await mock.listen();
+    let poolStats = null;
+    const poolId = await poolMining.start({ poolUrl: `${scheme}+tcp://127.0.0.1:${port}`, address: 'test', channel, threads: 1 },
+      (s) => { poolStats = s; });
+    await until(() => mock.stats.accepted > 0);
+    const before = mock.stats.accepted;
+    // v1 switches on a non-clean notify: late shares of the first job still count.
+    const jobId = mock.notify(scheme !== 'stratum');
+    await until(() => mock.stats.accepted > before && poolStats && String(poolStats.pool.jobId) !== '1');
+    poolMining.stop(poolId);
+    await mock.close();
+    assert.ok(before > 0 && mock.stats.accepted > before, `${scheme} ${channel || ''}: shares accepted on both jobs`);
+    assert.strictEqual(mock.stats.rejected + mock.stats.duplicate, 0);
+    assert.strictEqual(String(poolStats.pool.jobId), scheme === 'stratum' ? jobId : String(parseInt(jobId, 16)));
+    assert.ok(poolStats.pool.accepted > 0 && poolStats.pool.latencyMs.avg > 0);
+  }
+  // Miner options refused after the connect leave no pool session behind.
+  const refusing = new MockPool();
+  const refusingPort = await refusing.listen();
+  await assert.rejects(poolMining.start({ poolUrl: `stratum+tcp://127.0.0.1:${refusingPort}`, address: 'test', coin: 'nope' }), /Unknown coin/);
+  await until(() => refusing.clients.size === 0);
+  assert.strictEqual(refusing.clients.size, 0);
+  await refusing.close();
+  // A submit the pool never answers is counted as rejected after the
+  // request timeout, directly and through the proxy.
+  const silent = new MockPool();
+  const answer = silent._onRequest.bind(silent);
+  silent._onRequest = (c, msg) => msg.method !== 'mining.submit' && answer(c, msg);
+  const silentPort = await silent.listen();
+  const silentUrl = `stratum+tcp://127.0.0.1:${silentPort}`;
+  const direct = new poolMining.StratumClient({ url: silentUrl, user: 'test', requestTimeoutMs: 100 });
+  await direct.connect();
+  const unanswered = await direct.submit({ jobId: '1', extranonce: 0, time: 0, nonce: 0 });
+  assert.ok(!unanswered.accepted && /timed out/.test(unanswered.error));
+  assert.strictEqual(direct.pending.size, 0);
+  assert.strictEqual(direct.stats().rejected, 1);
+  direct.close();
+  // A malformed line only drops that connection.
+  const garbled = net.connect(silentPort, '127.0.0.1');
+  await new Promise(resolve => garbled.on('close', resolve).on('error', () => {}).write('{not json\n'));
+  await until(() => silent.clients.size === 0);
+  assert.strictEqual(silent.clients.size, 0);
+  const silentProxy = new StratumProxy({ url: silentUrl, user: 'farm', requestTimeoutMs: 100 });
+  await silentProxy.start();
+  const behind = new poolMining.StratumClient({ url: silentProxy.url, user: 'test', requestTimeoutMs: 5000 });
+  await behind.connect();
+  const relayed = await behind.submit({ jobId: '1', extranonce: 0, time: 0, nonce: 0 });
+  assert.ok(!relayed.accepted && /timed out/.test(relayed.error));
+  behind.close();
+  silentProxy.stop();
+  await silent.close();
+  console.log('PASS: Stratum v1 and v2 clients mine mock pool jobs and pipeline submits.');
+
+  // Two miners behind the local proxy: one pool session, disjoint
+  // extranonce2 slots, every share accepted and credited to its miner.
+  const upstream = new MockPool();
+  const upstreamPort = await upstream.listen();
+  const proxy = new StratumProxy({ url: `stratum+tcp://127.0.0.1:${upstreamPort}`, user: 'farm' });
+  await proxy.start();
+  const workers = await Promise.all(['a', 'b'].map(address => poolMining.start({ poolUrl: proxy.url, address, threads: 1 }, () => {})));
+  const credited = () => proxy.stats().downstreams.filter(d => d.accepted > 0).length;
+  await until(() => credited() === 2);
+  const proxied = proxy.stats();
+  const sessions = upstream.clients.size;
+  workers.forEach(id => poolMining.stop(id));
+  proxy.stop();
+  // The app's proxies: one per pool and user, a second user does not stop the first.
+  const upstreamUrl = `stratum+tcp://127.0.0.1:${upstreamPort}`;
+  const [p1, p2, p1again] = await Promise.all([
+    ensureProxy({ url: upstreamUrl, user: 'one' }), ensureProxy({ url: upstreamUrl, user: 'two' }), ensureProxy({ url: upstreamUrl, user: 'one' })
+  ]);
+  assert.ok(p1 === p1again && p1 !== p2 && !p1.closed && !p2.closed);
+  await stopProxy();
+  assert.ok(p1.closed && p2.closed);
+  // A proxy no miner ever connects to stops on its own.
+  const unused = await ensureProxy({ url: upstreamUrl, user: 'nobody', idleMs: 50 });
+  await until(() => unused.closed);
+  assert.ok(unused.closed);
+  // A miner that reconnects within idleMs (a restart) finds the proxy up,
+  // and slots stay unique among the miners connected after it.
+  const kept = await ensureProxy({ url: upstreamUrl, user: 'restart', idleMs: 1000 });
+  const before = new poolMining.StratumClient({ url: kept.url, user: 'a' });
+  await before.connect();
+  before.close();
+  await until(() => kept.downstreams.size === 0);
+  const after = new poolMining.StratumClient({ url: kept.url, user: 'a' });
+  const other = new poolMining.StratumClient({ url: kept.url, user: 'b' });
+  await after.connect();
+  await other.connect();
+  assert.ok(!kept.closed);
+  assert.notStrictEqual(after.extranonce1, other.extranonce1);
+  after.close();
+  other.close();
+  await until(() => kept.closed);
+  assert.ok(kept.closed);
+  // A pool-side extranonce change reaches subscribed downstreams behind
+  // their slot prefix; the others are dropped to reconnect.
+  const moving = new StratumProxy({ url: upstreamUrl, user: 'farm' });
+  await moving.start();
+  const [told, untold] = [new poolMining.StratumClient({ url: moving.url, user: 'a' }), new poolMining.StratumClient({ url: moving.url, user: 'b' })];
+  await Promise.all([told.connect(), untold.connect()]);
+  let dropped = false;
+  untold.on('close', () => { dropped = true; });
+  await told.request('mining.extranonce.subscribe', []);
+  const oldExtranonce1 = told.extranonce1;
+  upstream.setExtranonce();
+  await until(() => told.extranonce1 !== oldExtranonce1 && dropped);
+  assert.ok(dropped);
+  assert.strictEqual(told.extranonce1, moving.upstream.extranonce1 + oldExtranonce1.slice(-2 * moving.prefixBytes));
+  assert.strictEqual(told.extranonce2Size, moving.extranonce2Size);
+  told.close();
+  moving.stop();
+  await upstream.close();
+  assert.strictEqual(sessions, 1);
+  assert.strictEqual(upstream.stats.rejected + upstream.stats.duplicate, 0);
+  assert.strictEqual(proxied.downstreams.length, 2);
+  assert.deepStrictEqual(proxied.downstreams.map(d => d.user).sort(), ['a', 'b']);
+  assert.ok(proxied.downstreams.every(d => d.accepted > 0 && d.rejected === 0));
+  assert.ok(proxied.batches.count > 0 && proxied.batches.shares >= proxied.batches.count);
+  console.log('PASS: Stratum proxy shares one pool session between miners.');
+})().catch(e => {
+  console.error('FAIL:', e);
+  process.exit(1);
+});
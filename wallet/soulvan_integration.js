@@ -0,0 +1,39 @@
+const crypto = require('crypto');
+const { hashMany } = require('../mining/hash_many');
+
+const balances = new Map(); // address -> number
+const KEY_HEX_LENGTH = 64;
+
+// Derives `count` wallets in one batch: address = ripemd160(hex private key).
+function createWallets(count) {
+  const keys = crypto.randomBytes(32 * count).toString('hex');
+  const addresses = hashMany('ripemd160', Buffer.from(keys, 'latin1'), KEY_HEX_LENGTH, count);
+  const wallets = [];
+  for (let i = 0; i < count; i++) {
+    const privateKey = keys.slice(i * KEY_HEX_LENGTH, (i + 1) * KEY_HEX_LENGTH);
+    const address = addresses.toString('hex', i * 20, (i + 1) * 20);
+    balances.set(address, (Math.random() * 10).toFixed(6) * 1);
+    wallets.push({ address, privateKey });
+  }
+  return wallets;
+}
+
+function createWallet() {
+  return createWallets(1)[0];
+}
+
+function getBalance(address) {
+  const bal = balances.get(address) || 0;
+  return { coin: 'soulvan', address, balance: bal };
+}
+
+function send(from, to, amount) {
+  amount = Number(amount);
+  const fromBal = balances.get(from) || 0;
+  if (fromBal < amount) return { ok: false, error: 'Insufficient balance (demo)' };
+  balances.set(from, fromBal - amount);
+  balances.set(to, (balances.get(to) || 0) + amount);
+  return { ok: true, txid: crypto.randomBytes(16).toString('hex') };
+}
+
+module.exports = { createWallet, createWallets, getBalance, send };
\ No newline at end of file